@@ -0,0 +1,50 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <kahan-float/mmap.hpp>
+
+// ==========================================
+//   compensated sum of a raw binary column
+//
+// usage: app_sumfile [-f|-d] [-t threads] file
+//   -f: file of float (32 bits)
+//   -d: file of double (64 bits, default)
+// ==========================================
+
+int
+main(int argc, char* argv[])
+{
+   bool is_float = false;
+   unsigned threads = 0; // all cores
+   const char* path = nullptr;
+   for (int i = 1; i < argc; i++) {
+      if (!strcmp(argv[i], "-f"))
+         is_float = true;
+      else if (!strcmp(argv[i], "-d"))
+         is_float = false;
+      else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+         threads = (unsigned)atoi(argv[++i]);
+      else
+         path = argv[i];
+   }
+   if (!path) {
+      fprintf(stderr, "usage: %s [-f|-d] [-t threads] file\n", argv[0]);
+      return 2;
+   }
+
+   // float files are also accumulated in double
+   kahan::nbfloat64 sum;
+   bool ok = is_float ? kahan::sum_file<double, float>(path, sum, threads)
+                      : kahan::sum_file<double, double>(path, sum, threads);
+   if (!ok) {
+      fprintf(stderr, "%s: cannot sum '%s' (%s)\n", argv[0], path,
+              strerror(errno));
+      return 1;
+   }
+   printf("%.*g\n", std::numeric_limits<double>::max_digits10,
+          sum.getValue());
+   return 0;
+}
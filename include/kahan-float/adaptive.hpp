@@ -0,0 +1,289 @@
+#pragma once
+
+// adaptive.hpp: accumulator that escalates its precision only when needed
+//
+// tadaptive<T> starts as a Kahan sum (as kfloat64) and keeps the number of
+// elements and the plain sum of |x|. Every 'check_every' elements the
+// condition of the sum (sum|x| / |sum|) is compared with what the current
+// mode can handle, and the state is moved (exactly) to the next mode while
+// its error bound would be above about one ulp of the sum:
+//
+//   kahan          2u sum|x|             (kept while sum|x| <= 4 |sum|)
+//   neumaier       (n u)^2 sum|x|        (TwoSum, as nfloat64)
+//   double_double  2 n u^2 sum|x|        (TwoSum, renormalized each step)
+//   exact          correctly rounded     (tshewchuk, as sfloat64)
+//
+// 'add(data, count)' also checks each block before adding it (from its
+// plain sum), so it switches before any digit is lost. Errors made before a
+// switch are not recovered: they are kept in 'error_bound()'. Non-finite
+// inputs switch to exact mode, which gives the same inf/nan results as fsum.
+
+#include <cmath>    // fabs, isfinite, isnan
+#include <cstddef>  // size_t
+#include <iostream>
+#include <limits>
+//
+#include "eft.hpp"      // two_sum, two_sum_error, fast_two_sum_error
+#include "fsum.hpp"     // tshewchuk
+#include "tracked.hpp"  // detail::gamma, detail::true_abs_sum
+
+namespace kahan {
+
+enum class adaptive_mode { kahan, neumaier, double_double, exact };
+
+template <class T>
+struct tadaptive {
+ private:
+  adaptive_mode mode{adaptive_mode::kahan};
+  // (value, pending correction) in kahan and neumaier modes (kahan 'c' is
+  // minus the lost digits), (hi, lo) in double_double mode
+  T val{0};
+  T c{0};
+  // exact mode only
+  tshewchuk<T> exact;
+  // number of elements and plain sum of |x|
+  std::size_t n{0};
+  T abs_sum{0};
+  // error bound of previous modes
+  T err{0};
+  // elements since last check
+  std::size_t pending{0};
+
+ public:
+  // elements between two checks of the condition
+  static constexpr std::size_t check_every = 64;
+
+  // build with T value (not 'explicit', may be automatic!)
+  tadaptive(T _val) { (*this) += _val; }
+
+  // empty
+  tadaptive() {}
+
+  adaptive_mode getMode() const { return this->mode; }
+
+  T getValue() const {
+    switch (this->mode) {
+      case adaptive_mode::kahan:
+        return this->val;
+      case adaptive_mode::exact:
+        return this->exact.getValue();
+      default:
+        return this->val + this->c;
+    }
+  }
+
+  explicit operator T() const { return this->getValue(); }
+
+  // number of elements added
+  std::size_t getCount() const { return this->n; }
+
+  // bound on |getValue() - exact sum| ('inf' if not finite)
+  T error_bound() const {
+    const T inf = std::numeric_limits<T>::infinity();
+    const T v = this->getValue();
+    if (!std::isfinite(v) || !std::isfinite(this->abs_sum)) return inf;
+    const T u = std::numeric_limits<T>::epsilon() / 2;
+    return this->err + this->mode_bound() + u * std::fabs(v);
+  }
+
+  // copy assignment (for any valid element)
+  template <class X>
+  tadaptive<T>& operator+=(const X& _add) {
+    T add = static_cast<T>(_add);  // converting to correct type
+    if (!std::isfinite(add)) this->escalate(adaptive_mode::exact);
+    this->step(add);
+    this->n++;
+    this->abs_sum += std::fabs(add);
+    if (++this->pending == check_every) this->check();
+    return *this;
+  }
+
+  // adds 'count' elements of 'data' (one mode dispatch per block). Each
+  // block is checked before it is added, from its plain sum.
+  tadaptive<T>& add(const T* data, std::size_t count) {
+    while (count > 0) {
+      std::size_t b = check_every - this->pending;
+      if (b > count) b = count;
+      T a = 0;
+      T p = 0;
+      for (std::size_t i = 0; i < b; i++) {
+        a += std::fabs(data[i]);
+        p += data[i];
+      }
+      if (!std::isfinite(a) || !std::isfinite(p)) {
+        this->escalate(adaptive_mode::exact);
+      } else {
+        const T v = this->getValue() + p;
+        while (!this->enough(this->n + b, this->abs_sum + a, v))
+          this->escalate(adaptive_mode(int(this->mode) + 1));
+      }
+      switch (this->mode) {
+        case adaptive_mode::kahan:
+          for (std::size_t i = 0; i < b; i++) this->step_kahan(data[i]);
+          break;
+        case adaptive_mode::neumaier:
+          for (std::size_t i = 0; i < b; i++) this->step_neumaier(data[i]);
+          break;
+        case adaptive_mode::double_double:
+          for (std::size_t i = 0; i < b; i++) this->step_dd(data[i]);
+          break;
+        case adaptive_mode::exact:
+          this->exact.add(data, data + b);
+          break;
+      }
+      this->n += b;
+      this->abs_sum += a;
+      this->pending += b;
+      if (this->pending == check_every) this->check();
+      data += b;
+      count -= b;
+    }
+    return *this;
+  }
+
+  // copy assignment (for any valid element)
+  template <class X>
+  tadaptive<T>& operator-=(const X& add) {
+    (*this) += -add;  // reuse '+='
+    return *this;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend tadaptive<T> operator+(tadaptive<T> lhs, const X& rhs) {
+    lhs += rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend tadaptive<T> operator-(tadaptive<T> lhs, const X& rhs) {
+    lhs += -rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // ==================
+
+  friend std::ostream& operator<<(std::ostream& os, const tadaptive<T>& k) {
+    os << k.getValue();
+    return os;
+  }
+
+ private:
+  // same as tkahan
+  void step_kahan(T x) {
+    T y = x - this->c;
+    T t = this->val + y;
+    this->c = -eft::fast_two_sum_error(this->val, y, t);
+    this->val = t;
+    this->c = std::isnan(this->c) ? T(0) : this->c;
+  }
+
+  // same as tneumaier (branchless step)
+  void step_neumaier(T x) {
+    T t = this->val + x;
+    this->c += eft::two_sum_error(this->val, x, t);
+    this->val = t;
+    this->c = std::isnan(this->c) ? T(0) : this->c;
+  }
+
+  // double-length sum: (hi, lo) renormalized so that |lo| <= ulp(hi) / 2
+  void step_dd(T x) {
+    T s = this->val + x;
+    T lo = this->c + eft::two_sum_error(this->val, x, s);
+    lo = std::isnan(lo) ? T(0) : lo;
+    eft::two_sum(s, lo, this->val, this->c);
+    this->c = std::isnan(this->c) ? T(0) : this->c;
+  }
+
+  void step(T x) {
+    switch (this->mode) {
+      case adaptive_mode::kahan:
+        this->step_kahan(x);
+        break;
+      case adaptive_mode::neumaier:
+        this->step_neumaier(x);
+        break;
+      case adaptive_mode::double_double:
+        this->step_dd(x);
+        break;
+      case adaptive_mode::exact:
+        this->exact += x;
+        break;
+    }
+  }
+
+  // error bound of current mode (without final rounding)
+  T mode_bound() const {
+    const T u = std::numeric_limits<T>::epsilon() / 2;
+    const T g = detail::gamma<T>(this->n);
+    const T s = detail::true_abs_sum(this->abs_sum, this->n);
+    switch (this->mode) {
+      case adaptive_mode::kahan:
+        return (2 * u + u * detail::gamma<T>(4 * this->n)) * s;
+      case adaptive_mode::neumaier:
+        return g * g * s;
+      case adaptive_mode::double_double:
+        return 2 * u * g * s;
+      default:
+        return T(0);
+    }
+  }
+
+  // true if current mode is enough for a sum of 'm' elements, with plain
+  // sum of |x| 'a' and value 'v'
+  bool enough(std::size_t m, T a, T v) const {
+    if (!std::isfinite(a)) return false;
+    const T u = std::numeric_limits<T>::epsilon() / 2;
+    const T nu = T(m) * u;
+    v = std::fabs(v);
+    switch (this->mode) {
+      case adaptive_mode::kahan:
+        return a <= 4 * v;
+      case adaptive_mode::neumaier:
+        return T(m) * nu * a <= v;
+      case adaptive_mode::double_double:
+        return 2 * nu * a <= v;
+      default:
+        return true;
+    }
+  }
+
+  void check() {
+    this->pending = 0;
+    while (!this->enough(this->n, this->abs_sum, this->getValue()))
+      this->escalate(adaptive_mode(int(this->mode) + 1));
+  }
+
+  // moves (exactly) the state to a more precise mode
+  void escalate(adaptive_mode to) {
+    while (this->mode < to) {
+      this->err += this->mode_bound();
+      switch (this->mode) {
+        case adaptive_mode::kahan:
+          this->c = -this->c;
+          this->mode = adaptive_mode::neumaier;
+          break;
+        case adaptive_mode::neumaier:
+          if (std::isfinite(this->val))
+            eft::two_sum(this->val, this->c, this->val, this->c);
+          this->mode = adaptive_mode::double_double;
+          break;
+        default:
+          this->exact += this->val;
+          if (std::isfinite(this->val)) this->exact += this->c;
+          this->val = 0;
+          this->c = 0;
+          this->mode = adaptive_mode::exact;
+          break;
+      }
+    }
+  }
+};
+
+// =========================================================
+
+using afloat32 = tadaptive<float>;
+using afloat64 = tadaptive<double>;
+
+}  // namespace kahan
@@ -0,0 +1,143 @@
+#pragma once
+
+// aligned.hpp: aligned and cache-line-padded accumulators
+//
+// 'padded<Acc>' is an accumulator alone on its cache line, so threads
+// updating neighbouring accumulators (one per thread or task) do not
+// invalidate each other's lines (false sharing). 'lane_accumulator<T>'
+// keeps the lanes of the bulk kernel (see sum.hpp) across calls, packed in
+// SIMD-width aligned groups. 'aligned_allocator' gives storage on any
+// power-of-two boundary (also for over-aligned types before C++17).
+//
+// The cache line size is 'KAHAN_CACHE_LINE' (64 by default).
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uintptr_t
+#include <cstdlib>  // posix_memalign, free, abort
+#include <limits>   // numeric_limits
+#include <new>      // bad_alloc
+#include <vector>
+//
+#include "neumaier.hpp"  // tneumaier (result type)
+#include "sum.hpp"       // bulk_lanes, detail::add_lanes, fold_partials
+
+#ifndef KAHAN_CACHE_LINE
+#define KAHAN_CACHE_LINE 64
+#endif
+
+namespace kahan {
+
+constexpr std::size_t cache_line = KAHAN_CACHE_LINE;
+
+// allocates on 'Align' boundaries; throws 'std::bad_alloc' on failure, like
+// 'std::allocator' (aborts when exceptions are disabled)
+template <class T, std::size_t Align = cache_line>
+class aligned_allocator {
+  static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align is below alignment of T");
+
+ public:
+  using value_type = T;
+
+  template <class U>
+  struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+
+  aligned_allocator() {}
+
+  template <class U>
+  aligned_allocator(const aligned_allocator<U, Align>&) {}
+
+  T* allocate(std::size_t n) {
+    void* p = nullptr;
+    // posix_memalign needs a multiple of sizeof(void*)
+    const std::size_t a = (Align < sizeof(void*)) ? sizeof(void*) : Align;
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T) ||
+        ::posix_memalign(&p, a, n * sizeof(T)) != 0) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+      throw std::bad_alloc();
+#else
+      std::abort();
+#endif
+    }
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t) { std::free(p); }
+
+  template <class U>
+  bool operator==(const aligned_allocator<U, Align>&) const {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const aligned_allocator<U, Align>&) const {
+    return false;
+  }
+};
+
+// e.g. 'aligned_vector<double>' (cache line) or 'aligned_vector<float, 32>'
+template <class T, std::size_t Align = cache_line>
+using aligned_vector = std::vector<T, aligned_allocator<T, Align>>;
+
+// true if 'p' is on an 'align' boundary
+inline bool is_aligned(const void* p, std::size_t align) {
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+// =========================================================
+
+// accumulator 'Acc' aligned (and padded) to 'Align' bytes, used as an 'Acc'
+// (e.g. in 'std::vector<padded<kfloat64>>' with 'aligned_allocator')
+template <class Acc, std::size_t Align = cache_line>
+struct alignas(Align) padded : Acc {
+  using Acc::Acc;
+
+  padded() {}
+
+  padded(const Acc& acc) : Acc(acc) {}
+};
+
+// =========================================================
+
+// running bulk sum: lanes of 'bulk_lanes<T>' sums and errors, each group
+// aligned to its size (one or more SIMD registers), folded on read
+template <class T>
+class alignas(sizeof(T) * bulk_lanes<T>::value) lane_accumulator {
+ public:
+  static constexpr std::size_t lanes = bulk_lanes<T>::value;
+
+ private:
+  T s[lanes];
+  T c[lanes];
+
+ public:
+  lane_accumulator() { this->clear(); }
+
+  void clear() {
+    for (std::size_t k = 0; k < lanes; k++) {
+      this->s[k] = 0;
+      this->c[k] = 0;
+    }
+  }
+
+  // adds 'n' elements of 'data' (lanes are only folded on read, so chunks
+  // with multiples of 'lanes' elements give the result of a single call)
+  template <class X>
+  lane_accumulator& add(const X* data, std::size_t n) {
+    detail::add_lanes(data, n, this->s, this->c);
+    return *this;
+  }
+
+  // folded lanes (value and pending correction)
+  tneumaier<T, neumaier_branchless> getSum() const {
+    T fs, fc;
+    detail::fold_partials(this->s, this->c, lanes, fs, fc);
+    return tneumaier<T, neumaier_branchless>(fs, fc);
+  }
+
+  T getValue() const { return this->getSum().getValue(); }
+};
+
+}  // namespace kahan
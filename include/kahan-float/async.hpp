@@ -0,0 +1,245 @@
+#pragma once
+
+// async.hpp: streaming compensated sums of chunked producers (C++20
+// coroutines)
+//
+// A producer (file reader, decoder...) is a coroutine returning
+// 'chunk_generator<T>' that fills buffers from 'co_await next_buffer<T>{n}'
+// and 'co_yield's chunks of them. 'stream_add' resumes each source on its
+// own thread, one chunk ahead of the sums, so reading chunk k+1 overlaps
+// with summing chunk k (double-buffering: the generator owns two buffers,
+// used in turns, which outlive the coroutine body). Sources are summed
+// into their own partials, which are merged in source order, so results do
+// not depend on timing.
+//
+// Needs C++20 <coroutine> ('KAHAN_HAS_COROUTINES' is then 1).
+
+#include <cstddef>  // size_t
+#include <cstdio>   // FILE, fread
+#include <vector>
+//
+#include "merge.hpp"  // merge
+#include "sum.hpp"    // bulk_add
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#endif
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+#define KAHAN_HAS_COROUTINES 1
+#include <condition_variable>
+#include <exception>  // terminate
+#include <mutex>
+#include <thread>
+#include <utility>  // exchange
+#else
+#define KAHAN_HAS_COROUTINES 0
+#endif
+
+#if KAHAN_HAS_COROUTINES
+
+namespace kahan {
+
+// 'size' values starting at 'data'
+template <class T>
+struct chunk {
+  const T* data;
+  std::size_t size;
+};
+
+// coroutine of chunks: 'co_yield chunk<T>{p, n}'
+template <class T>
+class chunk_generator {
+ public:
+  struct promise_type {
+    chunk<T> current{nullptr, 0};
+    std::vector<T> buf[2];
+    unsigned k{1};
+
+    // the buffer not yielded last, with 'n' values
+    T* buffer(std::size_t n) {
+      this->k ^= 1u;
+      if (this->buf[this->k].size() < n) this->buf[this->k].resize(n);
+      return this->buf[this->k].data();
+    }
+
+    chunk_generator get_return_object() {
+      return chunk_generator(handle::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    std::suspend_always yield_value(chunk<T> c) noexcept {
+      this->current = c;
+      return {};
+    }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  using handle = std::coroutine_handle<promise_type>;
+
+  chunk_generator(chunk_generator&& other) noexcept
+      : h(std::exchange(other.h, {})) {}
+
+  chunk_generator& operator=(chunk_generator&& other) noexcept {
+    if (this != &other) {
+      if (this->h) this->h.destroy();
+      this->h = std::exchange(other.h, {});
+    }
+    return *this;
+  }
+
+  ~chunk_generator() {
+    if (this->h) this->h.destroy();
+  }
+
+  // runs producer until next chunk (false when it returns)
+  bool next() {
+    if (!this->h || this->h.done()) return false;
+    this->h.resume();
+    return !this->h.done();
+  }
+
+  // last chunk yielded
+  chunk<T> value() const { return this->h.promise().current; }
+
+ private:
+  handle h;
+
+  explicit chunk_generator(handle _h) : h(_h) {}
+};
+
+// in a 'chunk_generator<T>': 'T* p = co_await next_buffer<T>{n}' gives a
+// buffer of 'n' values, valid until the chunk after next is yielded
+template <class T>
+struct next_buffer {
+  std::size_t n;
+  T* p{nullptr};
+
+  bool await_ready() const noexcept { return false; }
+
+  // never suspends
+  bool await_suspend(
+      std::coroutine_handle<typename chunk_generator<T>::promise_type> h) {
+    this->p = h.promise().buffer(this->n);
+    return false;
+  }
+
+  T* await_resume() const noexcept { return this->p; }
+};
+
+// binary T values of 'f', in chunks of 'n' (until end of file or error, see
+// 'ferror')
+template <class T>
+chunk_generator<T> read_chunks(std::FILE* f, std::size_t n) {
+  for (;;) {
+    T* p = co_await next_buffer<T>{n};
+    const std::size_t r = std::fread(p, sizeof(T), n, f);
+    if (r > 0) co_yield chunk<T>{p, r};
+    if (r < n) co_return;
+  }
+}
+
+namespace detail {
+
+// one chunk handed from a producer thread to the consumer
+template <class T>
+struct stream_slot {
+  chunk<T> c{nullptr, 0};
+  bool full{false};  // until summed
+  bool done{false};
+  bool finished{false};  // seen by consumer
+};
+
+}  // namespace detail
+
+// adds all chunks of all 'sources' to 'acc' (see above)
+template <class Acc, class T>
+Acc& stream_add(Acc& acc, std::vector<chunk_generator<T>>& sources) {
+  const std::size_t m = sources.size();
+  std::vector<Acc> part(m);
+  std::vector<detail::stream_slot<T>> slot(m);
+  std::mutex mtx;
+  std::condition_variable cv;
+
+  std::vector<std::thread> producers;
+  producers.reserve(m);
+  for (std::size_t i = 0; i < m; i++) {
+    producers.emplace_back([&, i]() {
+      for (;;) {
+        const bool more = sources[i].next();  // overlaps with sums
+        std::unique_lock<std::mutex> lock(mtx);
+        // previous chunk is summed: its buffer may be reused after this one
+        cv.wait(lock, [&]() { return !slot[i].full; });
+        if (more) {
+          slot[i].c = sources[i].value();
+          slot[i].full = true;
+        } else {
+          slot[i].done = true;
+        }
+        cv.notify_all();
+        if (!more) return;
+      }
+    });
+  }
+
+  std::size_t left = m;
+  std::unique_lock<std::mutex> lock(mtx);
+  while (left > 0) {
+    cv.wait(lock, [&]() {
+      for (std::size_t i = 0; i < m; i++)
+        if (slot[i].full || (slot[i].done && !slot[i].finished)) return true;
+      return false;
+    });
+    for (std::size_t i = 0; i < m; i++) {
+      if (slot[i].full) {
+        const chunk<T> c = slot[i].c;
+        lock.unlock();
+        bulk_add(part[i], c.data, c.size);
+        lock.lock();
+        slot[i].full = false;
+        cv.notify_all();
+      } else if (slot[i].done && !slot[i].finished) {
+        slot[i].finished = true;
+        left--;
+      }
+    }
+  }
+  lock.unlock();
+  for (std::size_t i = 0; i < m; i++) producers[i].join();
+
+  // in source order
+  for (std::size_t i = 0; i < m; i++) {
+    if constexpr (requires { merge(acc, part[i]); })
+      merge(acc, part[i]);
+    else
+      acc += part[i].getValue();
+  }
+  return acc;
+}
+
+// compensated sum of all chunks of 'sources'
+template <class Acc, class T>
+Acc stream_sum(std::vector<chunk_generator<T>>& sources) {
+  Acc acc;
+  stream_add(acc, sources);
+  return acc;
+}
+
+template <class Acc, class T>
+Acc stream_sum(chunk_generator<T> source) {
+  std::vector<chunk_generator<T>> sources;
+  sources.push_back(std::move(source));
+  return stream_sum<Acc>(sources);
+}
+
+}  // namespace kahan
+
+#endif  // KAHAN_HAS_COROUTINES
@@ -0,0 +1,231 @@
+#pragma once
+
+// csv.hpp: streaming CSV/text ingestion fused with compensated accumulation
+//
+// Text is fed in chunks of any size (lines may be split across chunks) and
+// every numeric field is parsed and added straight into the accumulator of
+// its column: no intermediate vectors of values, no allocation per number.
+// Only a partial line is kept between chunks.
+//
+// Plain decimals (up to 19 significant digits that fit in 53 bits, powers of
+// ten up to 1e22) are parsed exactly by a portable fast path (Clinger), on
+// any standard. Other numbers use 'std::from_chars' with C++17 (Eisel-Lemire
+// on recent standard libraries), or 'strtod' before C++17. All paths are
+// locale independent: the decimal point is always '.'.
+
+#include <cstddef>  // size_t
+#include <clocale>  // localeconv
+#include <cstdint>  // uint64_t
+#include <cstdlib>  // strtod
+#include <cstring>  // memchr, memcpy
+#include <istream>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>  // from_chars
+#endif
+#endif
+
+namespace kahan {
+
+namespace detail {
+
+// Clinger's fast path: [+-]digits[.digits][(e|E)[+-]digits] whose digits
+// fit in 53 bits and with a power of ten up to 1e22 (both exact, so the
+// single multiply or divide is correctly rounded); false if not handled
+inline bool parse_decimal_fast(const char* p, const char* last, double& v) {
+  static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+  bool neg = false;
+  if (p != last && (*p == '+' || *p == '-')) neg = (*p++ == '-');
+  std::uint64_t m = 0;
+  int digits = 0;  // significant digits in 'm'
+  int e = 0;
+  bool any = false;
+  for (; p != last && static_cast<unsigned>(*p - '0') < 10; ++p) {
+    if (m != 0 || *p != '0') digits++;
+    m = m * 10 + static_cast<unsigned>(*p - '0');
+    any = true;
+  }
+  if (p != last && *p == '.') {
+    for (++p; p != last && static_cast<unsigned>(*p - '0') < 10; ++p) {
+      if (m != 0 || *p != '0') digits++;
+      m = m * 10 + static_cast<unsigned>(*p - '0');
+      e--;
+      any = true;
+    }
+  }
+  if (!any || digits > 19) return false;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool eneg = false;
+    if (p != last && (*p == '+' || *p == '-')) eneg = (*p++ == '-');
+    if (p == last) return false;
+    int x = 0;
+    for (; p != last && static_cast<unsigned>(*p - '0') < 10; ++p) {
+      if (x > 1000) return false;
+      x = x * 10 + (*p - '0');
+    }
+    e += eneg ? -x : x;
+  }
+  if (p != last || m > (std::uint64_t(1) << 53) || e < -22 || e > 22)
+    return false;
+  v = static_cast<double>(m);
+  v = (e < 0) ? v / pow10[-e] : v * pow10[e];
+  if (neg) v = -v;
+  return true;
+}
+
+// parses whole [first, last) as a decimal number
+inline bool parse_double(const char* first, const char* last, double& v) {
+  if (first == last) return false;
+  if (parse_decimal_fast(first, last, v)) return true;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  if (*first == '+') {  // not accepted by from_chars
+    ++first;
+    if (first == last || *first == '-' || *first == '+') return false;
+  }
+  std::from_chars_result r = std::from_chars(first, last, v);
+  return r.ec == std::errc() && r.ptr == last;
+#else
+  // strtod needs a terminated string (numbers are short)
+  char buf[64];
+  std::size_t n = static_cast<std::size_t>(last - first);
+  if (n >= sizeof(buf)) return false;
+  std::memcpy(buf, first, n);
+  buf[n] = '\0';
+  // strtod follows LC_NUMERIC: accept '.' only, as the decimal point
+  const char point = *std::localeconv()->decimal_point;
+  if (point != '.') {
+    for (std::size_t k = 0; k < n; k++) {
+      if (buf[k] == point) return false;
+      if (buf[k] == '.') buf[k] = point;
+    }
+  }
+  char* end = nullptr;
+  v = std::strtod(buf, &end);
+  return end == buf + n;
+#endif
+}
+
+}  // namespace detail
+
+// column-wise sums of CSV text, one accumulator 'Acc' per column
+template <class Acc>
+class csv_sum {
+ private:
+  // one accumulator per column (grows with the widest line)
+  std::vector<Acc> cols;
+  // partial line between chunks
+  std::string carry;
+  char delim;
+  // first line still to be skipped
+  bool skip_header;
+  std::size_t nrows{0};
+  std::size_t nerrors{0};
+
+ public:
+  explicit csv_sum(char _delim = ',', bool _header = false)
+      : delim(_delim), skip_header(_header) {}
+
+  // feeds next chunk of text
+  void feed(const char* data, std::size_t n) {
+    const char* last = data + n;
+    const char* p = data;
+    if (!carry.empty()) {
+      // completes pending line first
+      const char* nl =
+          static_cast<const char*>(std::memchr(p, '\n', last - p));
+      if (!nl) {
+        carry.append(p, last);
+        return;
+      }
+      carry.append(p, nl);
+      line(carry.data(), carry.data() + carry.size());
+      carry.clear();
+      p = nl + 1;
+    }
+    while (p < last) {
+      const char* nl =
+          static_cast<const char*>(std::memchr(p, '\n', last - p));
+      if (!nl) {
+        carry.assign(p, last);
+        return;
+      }
+      line(p, nl);
+      p = nl + 1;
+    }
+  }
+
+  // ends input (last line may have no line break)
+  void finish() {
+    if (!carry.empty()) line(carry.data(), carry.data() + carry.size());
+    carry.clear();
+  }
+
+  const std::vector<Acc>& columns() const { return cols; }
+
+  // number of data lines (header and empty lines are not counted)
+  std::size_t rows() const { return nrows; }
+
+  // number of non-empty fields that are not numbers
+  std::size_t errors() const { return nerrors; }
+
+ private:
+  static bool is_space(char ch) { return ch == ' ' || ch == '\t'; }
+
+  void line(const char* first, const char* last) {
+    if (last > first && *(last - 1) == '\r') --last;  // CRLF
+    if (skip_header) {
+      skip_header = false;
+      return;
+    }
+    if (first == last) return;
+    nrows++;
+    std::size_t j = 0;
+    const char* p = first;
+    while (true) {
+      const char* end = static_cast<const char*>(
+          std::memchr(p, this->delim, last - p));
+      if (!end) end = last;
+      field(j, p, end);
+      if (end == last) break;
+      p = end + 1;
+      j++;
+    }
+  }
+
+  void field(std::size_t j, const char* first, const char* last) {
+    while (first < last && is_space(*first)) ++first;
+    while (last > first && is_space(*(last - 1))) --last;
+    if (first == last) return;  // missing value
+    double v;
+    if (!detail::parse_double(first, last, v)) {
+      nerrors++;
+      return;
+    }
+    if (j >= cols.size()) cols.resize(j + 1);
+    cols[j] += v;
+  }
+};
+
+// feeds all text from 'in' into 'out' (one reusable buffer, 1 MiB default)
+// returns false on read error
+template <class Acc>
+bool sum_csv(std::istream& in, csv_sum<Acc>& out,
+             std::size_t buffer_size = 1 << 20) {
+  std::vector<char> buf(buffer_size);
+  while (in) {
+    in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+    std::streamsize got = in.gcount();
+    if (got > 0) out.feed(buf.data(), static_cast<std::size_t>(got));
+  }
+  out.finish();
+  return in.eof() && !in.bad();
+}
+
+}  // namespace kahan
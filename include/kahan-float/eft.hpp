@@ -0,0 +1,177 @@
+#pragma once
+
+// eft.hpp: error-free transformations (building blocks of kahan.hpp and
+// neumaier.hpp, also useful for other compensated kernels)
+//
+// Each transformation returns a rounded result and its exact error:
+//   two_sum:      s + e == a + b           (Knuth, any a and b)
+//   fast_two_sum: s + e == a + b           (Dekker, requires |a| >= |b|)
+//   two_prod:     p + e == a * b           (FMA when fast, else Dekker)
+//   split:        hi + lo == a             (Veltkamp, half-width parts)
+//
+// All of them REQUIRE strict IEEE 754 arithmetic with round-to-nearest:
+// '-ffast-math' (or '/fp:fast', '-Ofast', icc defaults) may simplify the
+// error terms to zero. Batch versions are plain loops written to be
+// auto-vectorized (use -O3 and, if available, -mavx2 -mfma).
+
+#include <cmath>    // fma
+#include <cstddef>  // size_t
+#include <limits>   // numeric_limits
+
+#if defined(__FAST_MATH__) && !defined(KAHAN_ALLOW_FAST_MATH)
+#warning "kahan-float: error-free transformations are broken by fast-math"
+#endif
+
+// no-aliasing hint for batch versions
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define KAHAN_RESTRICT __restrict
+#else
+#define KAHAN_RESTRICT
+#endif
+
+namespace kahan {
+
+namespace eft {
+
+// =========================================================
+// scalar versions
+// ---------------------------------------------------------
+
+// error of 's = a + b' (s must be fl(a + b)), no assumption on magnitudes
+template <class T>
+inline T two_sum_error(T a, T b, T s) {
+  T bp = s - a;
+  return (a - (s - bp)) + (b - bp);
+}
+
+// error of 's = a + b' (s must be fl(a + b)), requires |a| >= |b|
+template <class T>
+inline T fast_two_sum_error(T a, T b, T s) {
+  return b - (s - a);
+}
+
+// s + e == a + b (6 flops)
+template <class T>
+inline void two_sum(T a, T b, T& s, T& e) {
+  s = a + b;
+  e = two_sum_error(a, b, s);
+}
+
+// s + e == a + b, requires |a| >= |b| (3 flops)
+template <class T>
+inline void fast_two_sum(T a, T b, T& s, T& e) {
+  s = a + b;
+  e = fast_two_sum_error(a, b, s);
+}
+
+// Veltkamp splitting factor: 2^ceil(digits/2) + 1
+template <class T>
+inline T split_factor() {
+  return T((1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+}
+
+// hi + lo == a, both with at most half of the mantissa bits
+// NOTE: must not be contracted into fma (see '-ffp-contract')
+template <class T>
+inline void split(T a, T& hi, T& lo) {
+  T c = split_factor<T>() * a;
+  hi = c - (c - a);
+  lo = a - hi;
+}
+
+// p + e == a * b, without fma (Dekker, 17 flops)
+template <class T>
+inline void two_prod_dekker(T a, T b, T& p, T& e) {
+  p = a * b;
+  T ah, al, bh, bl;
+  split(a, ah, al);
+  split(b, bh, bl);
+  e = al * bl - (((p - ah * bh) - al * bh) - ah * bl);
+}
+
+// p + e == a * b, with fma (2 flops)
+template <class T>
+inline void two_prod_fma(T a, T b, T& p, T& e) {
+  p = a * b;
+  e = std::fma(a, b, -p);
+}
+
+// p + e == a * b: uses fma only when it is done in hardware, since
+// software fma is much slower than Dekker product
+inline void two_prod(float a, float b, float& p, float& e) {
+#ifdef FP_FAST_FMAF
+  two_prod_fma(a, b, p, e);
+#else
+  two_prod_dekker(a, b, p, e);
+#endif
+}
+
+inline void two_prod(double a, double b, double& p, double& e) {
+#ifdef FP_FAST_FMA
+  two_prod_fma(a, b, p, e);
+#else
+  two_prod_dekker(a, b, p, e);
+#endif
+}
+
+inline void two_prod(long double a, long double b, long double& p,
+                     long double& e) {
+#ifdef FP_FAST_FMAL
+  two_prod_fma(a, b, p, e);
+#else
+  two_prod_dekker(a, b, p, e);
+#endif
+}
+
+// =========================================================
+// batch versions (element-wise over arrays, outputs must not alias)
+// ---------------------------------------------------------
+
+template <class T>
+inline void two_sum(const T* KAHAN_RESTRICT a, const T* KAHAN_RESTRICT b,
+                    T* KAHAN_RESTRICT s, T* KAHAN_RESTRICT e, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    T si = a[i] + b[i];
+    T bp = si - a[i];
+    e[i] = (a[i] - (si - bp)) + (b[i] - bp);
+    s[i] = si;
+  }
+}
+
+template <class T>
+inline void fast_two_sum(const T* KAHAN_RESTRICT a, const T* KAHAN_RESTRICT b,
+                         T* KAHAN_RESTRICT s, T* KAHAN_RESTRICT e,
+                         std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    T si = a[i] + b[i];
+    e[i] = b[i] - (si - a[i]);
+    s[i] = si;
+  }
+}
+
+template <class T>
+inline void split(const T* KAHAN_RESTRICT a, T* KAHAN_RESTRICT hi,
+                  T* KAHAN_RESTRICT lo, std::size_t n) {
+  const T factor = split_factor<T>();
+  for (std::size_t i = 0; i < n; i++) {
+    T c = factor * a[i];
+    T h = c - (c - a[i]);
+    hi[i] = h;
+    lo[i] = a[i] - h;
+  }
+}
+
+template <class T>
+inline void two_prod(const T* KAHAN_RESTRICT a, const T* KAHAN_RESTRICT b,
+                     T* KAHAN_RESTRICT p, T* KAHAN_RESTRICT e, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    T pi, ei;
+    two_prod(a[i], b[i], pi, ei);
+    p[i] = pi;
+    e[i] = ei;
+  }
+}
+
+}  // namespace eft
+
+}  // namespace kahan
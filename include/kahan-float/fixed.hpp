@@ -0,0 +1,222 @@
+#pragma once
+
+// fixed.hpp: exact sums of integer and decimal fixed-point inputs
+//
+// tfixed<Den> sums integer 'units' (e.g. cents as int64_t, Den = 100) in a
+// 128-bit two's complement integer, so the sum is exact for up to 2^63
+// int64_t or uint64_t inputs (|sum| < 2^127). The value is units / Den, rounded
+// to double only on read ('getValue()'), or kept as a compensated pair
+// ('getKahan()').
+//
+// Bulk 'add' splits each input in 32-bit halves summed in independent
+// 64-bit lanes (plain integer adds, vectorized by the compiler), folded into
+// the 128-bit sum every 2^31 elements.
+
+#include <cmath>    // fma
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+//
+#include "fsum.hpp"   // tshewchuk
+#include "kahan.hpp"  // tkahan
+
+namespace kahan {
+
+template <std::int64_t Den = 1>
+struct tfixed {
+  static_assert(Den > 0 && Den <= (std::int64_t(1) << 53),
+                "Expected positive Den, exact in double");
+
+ private:
+  // 128-bit sum of units: hi * 2^64 + lo
+  std::uint64_t lo{0};
+  std::int64_t hi{0};
+
+ public:
+  // build with integer units (not 'explicit', may be automatic!)
+  tfixed(std::int64_t units) { (*this) += units; }
+
+  // build with 128-bit parts
+  tfixed(std::int64_t _hi, std::uint64_t _lo) : lo(_lo), hi(_hi) {}
+
+  // empty
+  tfixed() {}
+
+  std::int64_t getHi() const { return this->hi; }
+
+  std::uint64_t getLo() const { return this->lo; }
+
+  // units / Den, correctly rounded when Den is 1
+  double getValue() const {
+    double s, r;
+    this->units_pair(s, r);
+    if (Den == 1) return s;
+    double q, e;
+    this->divide(s, r, q, e);
+    return q + e;
+  }
+
+  // units / Den as a compensated pair
+  kfloat64 getKahan() const {
+    double s, r;
+    this->units_pair(s, r);
+    double q, e;
+    this->divide(s, r, q, e);
+    return kfloat64(q, -e);  // kahan 'c' is minus the lost digits
+  }
+
+  explicit operator double() const { return this->getValue(); }
+
+  // exact (for any integer type up to 64 bits, signed or unsigned)
+  template <class I>
+  tfixed<Den>& operator+=(const I& units) {
+    (*this) += widen(units);
+    return *this;
+  }
+
+  // exact
+  tfixed<Den>& operator+=(const tfixed<Den>& other) {
+    const std::uint64_t old = this->lo;
+    this->lo += other.lo;
+    this->hi += other.hi + (this->lo < old ? 1 : 0);
+    return *this;
+  }
+
+  // exact (also for INT64_MIN, negated in 128 bits)
+  template <class I>
+  tfixed<Den>& operator-=(const I& units) {
+    (*this) += -widen(units);  // reuse '+='
+    return *this;
+  }
+
+  // adds 'n' units of 'data' (lanes, vectorizable)
+  tfixed<Den>& add(const std::int64_t* data, std::size_t n) {
+    const std::size_t L = 8;
+    const std::size_t block = std::size_t(1) << 31;  // no lane overflow
+    while (n > 0) {
+      const std::size_t b = (n < block) ? n : block;
+      std::uint64_t low[L];  // sums of low 32 bits (unsigned)
+      std::int64_t high[L];  // sums of high 32 bits (signed)
+      for (std::size_t k = 0; k < L; k++) {
+        low[k] = 0;
+        high[k] = 0;
+      }
+      std::size_t i = 0;
+      for (; i + L <= b; i += L)
+        for (std::size_t k = 0; k < L; k++) {
+          const std::uint64_t u = static_cast<std::uint64_t>(data[i + k]);
+          low[k] += u & 0xffffffffu;
+          high[k] += static_cast<std::int64_t>(data[i + k]) >> 32;
+        }
+      for (std::size_t k = 0; i < b; i++, k++) {
+        const std::uint64_t u = static_cast<std::uint64_t>(data[i]);
+        low[k] += u & 0xffffffffu;
+        high[k] += static_cast<std::int64_t>(data[i]) >> 32;
+      }
+      for (std::size_t k = 0; k < L; k++) {
+        this->add_shifted(high[k]);
+        (*this) += tfixed<Den>(0, low[k]);
+      }
+      data += b;
+      n -= b;
+    }
+    return *this;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend tfixed<Den> operator+(tfixed<Den> lhs, const X& rhs) {
+    lhs += rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // reverse (unary minus): two's complement
+  tfixed<Den> operator-() const {
+    const std::uint64_t nlo = ~this->lo + 1;
+    const std::int64_t nhi = ~this->hi + (nlo == 0 ? 1 : 0);
+    return tfixed<Den>(nhi, nlo);
+  }
+
+  // ==================
+
+  // exact
+  bool operator==(const tfixed<Den>& other) const {
+    return (this->hi == other.hi) && (this->lo == other.lo);
+  }
+
+  bool operator!=(const tfixed<Den>& other) const {
+    return !((*this) == other);
+  }
+
+  // exact
+  bool operator<(const tfixed<Den>& other) const {
+    return (this->hi < other.hi) ||
+           (this->hi == other.hi && this->lo < other.lo);
+  }
+
+  bool operator>(const tfixed<Den>& other) const { return other < (*this); }
+
+  // ==================
+
+  friend std::ostream& operator<<(std::ostream& os, const tfixed<Den>& k) {
+    os << k.getValue();
+    return os;
+  }
+
+ private:
+  // integer units as 128 bits (sign-extended, or zero-extended if unsigned)
+  template <class I>
+  static tfixed<Den> widen(const I& units) {
+    static_assert(std::is_integral<I>::value,
+                  "Expected integer units (scale decimals by Den first)");
+    static_assert(sizeof(I) <= sizeof(std::int64_t),
+                  "Expected integer units up to 64 bits");
+    if (!std::is_signed<I>::value)
+      return tfixed<Den>(0, static_cast<std::uint64_t>(units));
+    const std::int64_t v = static_cast<std::int64_t>(units);
+    return tfixed<Den>(v < 0 ? -1 : 0, static_cast<std::uint64_t>(v));
+  }
+
+  // adds v * 2^32
+  void add_shifted(std::int64_t v) {
+    const std::uint64_t u = static_cast<std::uint64_t>(v);
+    tfixed<Den> t(v >> 32, u << 32);  // sign-extended 128-bit shift
+    (*this) += t;
+  }
+
+  // units as s + r, s correctly rounded and r the rounded rest
+  void units_pair(double& s, double& r) const {
+    // four 32-bit parts, each exact in double
+    const std::uint64_t h = static_cast<std::uint64_t>(this->hi);
+    const double p[4] = {
+        std::ldexp(double(static_cast<std::int32_t>(h >> 32)), 96),
+        std::ldexp(double(h & 0xffffffffu), 64),
+        std::ldexp(double(this->lo >> 32), 32),
+        double(this->lo & 0xffffffffu)};
+    tshewchuk<double> x;
+    for (int i = 0; i < 4; i++) x += p[i];
+    s = x.getValue();
+    x += -s;
+    r = x.getValue();
+  }
+
+  // (s + r) / Den as q + e (e rounded)
+  static void divide(double s, double r, double& q, double& e) {
+    const double d = double(Den);
+    q = s / d;
+    const double rem = std::fma(-q, d, s);  // exact remainder
+    e = (rem + r) / d;
+  }
+};
+
+// =========================================================
+
+using ifixed128 = tfixed<1>;    // integer units
+using cfixed128 = tfixed<100>;  // cents
+
+struct fixed_helper {
+  static_assert(sizeof(ifixed128) == 16, "Expected 16 bytes on ifixed128");
+};
+
+}  // namespace kahan
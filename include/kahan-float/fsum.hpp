@@ -0,0 +1,340 @@
+#pragma once
+
+// fsum.hpp: exactly rounded summation (Shewchuk expansions, like Python fsum)
+
+#include <cmath>    // isnan, isinf, fabs, ldexp
+#include <cstddef>  // size_t
+#include <iostream>
+#include <limits>
+#include <memory>   // unique_ptr
+#include <utility>  // move
+
+namespace kahan {
+
+namespace detail {
+
+// small buffer for expansion partials: first N elements live inside the
+// object, heap storage is only used when more partials are needed.
+// For double, the number of non-overlapping partials is bounded (~40).
+template <class T, std::size_t N>
+class partials_buffer {
+ private:
+  T local[N];
+  std::unique_ptr<T[]> heap;
+  T* ptr{local};
+  std::size_t sz{0};
+  std::size_t cap{N};
+
+ public:
+  partials_buffer() {}
+
+  partials_buffer(const partials_buffer& other) { (*this) = other; }
+
+  partials_buffer& operator=(const partials_buffer& other) {
+    if (this == &other) return *this;
+    this->sz = 0;
+    this->reserve(other.sz);
+    for (std::size_t i = 0; i < other.sz; i++) this->ptr[i] = other.ptr[i];
+    this->sz = other.sz;
+    return *this;
+  }
+
+  std::size_t size() const { return sz; }
+
+  std::size_t capacity() const { return cap; }
+
+  T& operator[](std::size_t i) { return ptr[i]; }
+
+  const T& operator[](std::size_t i) const { return ptr[i]; }
+
+  void reserve(std::size_t n) {
+    if (n <= cap) return;
+    std::size_t ncap = cap * 2;
+    while (ncap < n) ncap *= 2;
+    std::unique_ptr<T[]> nheap(new T[ncap]);
+    for (std::size_t i = 0; i < sz; i++) nheap[i] = ptr[i];
+    heap = std::move(nheap);
+    ptr = heap.get();
+    cap = ncap;
+  }
+
+  // shrinks (or grows) logical size, keeping capacity
+  void resize(std::size_t n) {
+    reserve(n);
+    sz = n;
+  }
+};
+
+}  // namespace detail
+
+// exact accumulator: keeps a non-overlapping expansion of all added values
+// (J. R. Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast
+// Robust Geometric Predicates, 1997) and rounds it correctly on read.
+// Same algorithm as Python 'math.fsum' (R. Hettinger, Recipe 393090).
+//
+// T must be float, double or long double with round-to-nearest arithmetic.
+// N is the number of partials stored without heap allocation.
+//
+// Python raises on intermediate overflow; here multiples of 'unit()' (half
+// the range of T) are moved out of the expansion into an overflow count
+// instead, so the sum stays exact (e.g. 'max + max - max' is 'max').
+template <class T, std::size_t N = 32>
+struct tshewchuk {
+ private:
+  // non-overlapping partials, increasing magnitude
+  detail::partials_buffer<T, N> partials;
+  // sum of non-finite inputs (inf, nan)
+  T special{0};
+  // sum of infinite inputs (nan here means 'inf - inf')
+  T inf{0};
+  // intermediate overflow, in multiples of 'unit()' (an integer)
+  T over{0};
+
+ public:
+  // build with T value (not 'explicit', may be automatic!)
+  tshewchuk(T _val) { (*this) += _val; }
+
+  // empty
+  tshewchuk() {}
+
+  // correctly rounded sum of all added values
+  T getValue() const {
+    if (special != 0) {  // also true for nan
+      if (std::isnan(inf))
+        return inf;  // inf - inf
+      else
+        return special;
+    }
+    if (over != 0) return this->fold_overflow();
+
+    std::size_t n = partials.size();
+    T hi = 0;
+    if (n == 0) return hi;
+    T lo = 0;
+    hi = partials[--n];
+    // sum from the top, stopping at the first inexact operation
+    while (n > 0) {
+      T x = hi;
+      T y = partials[--n];
+      hi = x + y;
+      T yr = hi - x;
+      lo = y - yr;
+      if (lo != 0) break;
+    }
+    // make half-even rounding work across multiple partials: if 'lo' and
+    // the next partial have the same sign, 'hi' must be rounded away
+    if (n > 0 && ((lo < 0 && partials[n - 1] < 0) ||
+                  (lo > 0 && partials[n - 1] > 0))) {
+      T y = lo * 2;
+      T x = hi + y;
+      T yr = x - hi;
+      if (y == yr) hi = x;
+    }
+    return hi;
+  }
+
+  // number of partials currently stored in the expansion
+  std::size_t size() const { return partials.size(); }
+
+  // i-th partial (increasing magnitude)
+  T partial(std::size_t i) const { return partials[i]; }
+
+  // sum of non-finite inputs (zero if none)
+  T getSpecial() const { return special; }
+
+  // sum of infinite inputs (zero if none)
+  T getInf() const { return inf; }
+
+  // intermediate overflow in multiples of 'unit()' (zero if none)
+  T getOverflow() const { return over; }
+
+  // 2^(max_exponent - 1): any finite value that overflows when added to
+  // one of smaller magnitude is at least 'unit()'
+  static T unit() {
+    return std::ldexp(T(1), std::numeric_limits<T>::max_exponent - 1);
+  }
+
+  // adds 'k' (an integer) times 'unit()' (used by merge)
+  tshewchuk<T, N>& add_units(T k) {
+    over += k;
+    return *this;
+  }
+
+  // restores a saved state: [first, last) must be a valid expansion, as
+  // given by 'partial' (used by deserialization)
+  template <class It>
+  void assign(It first, It last, T _special, T _inf, T _over = 0) {
+    partials.resize(0);
+    for (std::size_t i = 0; first != last; ++first, ++i) {
+      partials.resize(i + 1);
+      partials[i] = *first;
+    }
+    special = _special;
+    inf = _inf;
+    over = _over;
+  }
+
+  explicit operator T() const { return getValue(); }
+
+  // copy assignment (for any valid element)
+  template <class X>
+  tshewchuk<T, N>& operator+=(const X& _add) {
+    T x = _add;  // converting to correct type
+    if (!std::isfinite(x)) {
+      // non-finite values never enter the expansion
+      if (std::isinf(x)) inf += x;
+      special += x;
+      return *this;
+    }
+    // grow-expansion: propagate 'x' through all partials (TwoSum each)
+    std::size_t i = 0;
+    const std::size_t n = partials.size();
+    for (std::size_t j = 0; j < n; j++) {
+      T y = partials[j];
+      if (::fabs(x) < ::fabs(y)) {
+        T tmp = x;
+        x = y;
+        y = tmp;
+      }
+      T hi = x + y;
+      // intermediate overflow: |x| >= unit, so 'x -= unit' is exact (at
+      // most twice, then 'x + y' is finite)
+      while (!std::isfinite(hi)) {
+        const T sign = (x > 0) ? T(1) : T(-1);
+        x -= sign * unit();
+        over += sign;
+        if (::fabs(x) < ::fabs(y)) {
+          T tmp = x;
+          x = y;
+          y = tmp;
+        }
+        hi = x + y;
+      }
+      T lo = y - (hi - x);
+      if (lo != 0) partials[i++] = lo;
+      x = hi;
+    }
+    partials.resize(i + 1);
+    partials[i] = x;
+    return *this;
+  }
+
+  // bulk add (for any valid iterator)
+  template <class It>
+  tshewchuk<T, N>& add(It first, It last) {
+    for (; first != last; ++first) (*this) += *first;
+    return *this;
+  }
+
+  // reverse (unary minus)
+  tshewchuk<T, N> operator-() const {
+    tshewchuk<T, N> r(*this);
+    for (std::size_t i = 0; i < r.partials.size(); i++)
+      r.partials[i] = -r.partials[i];
+    r.special = -r.special;
+    r.inf = -r.inf;
+    r.over = -r.over;
+    return r;
+  }
+
+  // ------------------
+
+  // copy assignment (for any valid element)
+  template <class X>
+  tshewchuk<T, N>& operator-=(const X& add) {
+    (*this) += -add;  // reuse '+='
+    return *this;
+  }
+
+  // ------------------
+
+  // copy return (for any valid element)
+  template <class X>
+  friend tshewchuk<T, N> operator+(tshewchuk<T, N> lhs, const X& rhs) {
+    lhs += rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend tshewchuk<T, N> operator-(tshewchuk<T, N> lhs, const X& rhs) {
+    lhs += -rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // ==================
+
+  // comparisons use correctly rounded values (expansions are not unique)
+
+  bool operator==(const tshewchuk<T, N>& other) const {
+    return this->getValue() == other.getValue();
+  }
+
+  bool operator!=(const tshewchuk<T, N>& other) const {
+    return !((*this) == other);
+  }
+
+  bool operator<(const tshewchuk<T, N>& other) const {
+    return this->getValue() < other.getValue();
+  }
+
+  bool operator>(const tshewchuk<T, N>& other) const {
+    return this->getValue() > other.getValue();
+  }
+
+  bool operator<=(const tshewchuk<T, N>& other) const {
+    return this->getValue() <= other.getValue();
+  }
+
+  bool operator>=(const tshewchuk<T, N>& other) const {
+    return this->getValue() >= other.getValue();
+  }
+
+  // ==================
+
+  friend std::ostream& operator<<(std::ostream& os, const tshewchuk<T, N>& k) {
+    os << k.getValue();
+    return os;
+  }
+
+ private:
+  // value with pending overflow: 'over' units are added back to a copy, in
+  // halves (adding a half only overflows when the whole sum does). Each
+  // half moves the sum by unit/2 and the expansion is below 2 * unit, so
+  // this stops after a few steps, in range or overflowed (then +-inf).
+  T fold_overflow() const {
+    tshewchuk<T, N> t(*this);
+    t.over = 0;
+    const T half = (over > 0 ? unit() : -unit()) / 2;
+    for (T k = ::fabs(over); k > 0 && t.over == 0; k--) {
+      t += half;
+      t += half;
+    }
+    if (t.over != 0) return half * std::numeric_limits<T>::infinity();
+    return t.getValue();
+  }
+};
+
+// =========================================================
+
+using sfloat32 = tshewchuk<float>;
+using sfloat64 = tshewchuk<double>;
+using sfloat128 = tshewchuk<long double>;
+
+// =========================================================
+
+// bulk API: correctly rounded sum of [first, last)
+template <class T = double, class It>
+T fsum(It first, It last) {
+  tshewchuk<T> s;
+  s.add(first, last);
+  return s.getValue();
+}
+
+// bulk API: correctly rounded sum of 'n' elements from 'data'
+template <class T>
+T fsum(const T* data, std::size_t n) {
+  return fsum<T>(data, data + n);
+}
+
+}  // namespace kahan
@@ -0,0 +1,191 @@
+#pragma once
+
+// gemm.hpp: compensated matrix-matrix product
+//
+// Same structure as BLIS/GotoBLAS (F. G. Van Zee, R. A. van de Geijn.
+// BLIS: A Framework for Rapidly Instantiating BLAS Functionality. 2015):
+// blocks of B (kc x nc) and A (mc x kc) are packed into contiguous
+// micro-panels, and an mr x nr micro-kernel keeps its tile of C in
+// registers. Here the tile is a pair (sum, error) per element, and each
+// update is an error-free transformation:
+//
+// - gemm_mode::double_double: TwoProduct + TwoSum (Dot2), as accurate as
+//   computing in twice the working precision (see gemv.hpp)
+// - gemm_mode::kahan: rounded product + TwoSum, only summation errors are
+//   compensated (about twice as fast as double_double)
+//
+// Errors of C are kept in a workspace (same size as the columns of C of
+// each thread) between blocks of k, and only folded into C at the end.
+
+#include <cstddef>  // size_t
+#include <vector>
+//
+#include "eft.hpp"       // two_prod, two_sum_error
+#include "gemv.hpp"      // layout
+#include "parallel.hpp"  // detail::parallel_ranges
+
+namespace kahan {
+
+// accuracy of 'gemm'
+enum class gemm_mode { kahan, double_double };
+
+namespace detail {
+
+template <class T>
+struct gemm_blocking {
+  static constexpr std::size_t mr = 4;
+  static constexpr std::size_t nr = 32 / sizeof(T);  // one AVX register
+  static constexpr std::size_t kc = 256;              // A micro-panel in L1
+  static constexpr std::size_t mc = 64;               // packed A in L2
+  static constexpr std::size_t nc = 1024;             // packed B in L3
+  static_assert(mc % mr == 0 && nc % nr == 0, "Expected whole micro-panels");
+};
+
+// strided matrix: element (i, j) is p[i * rs + j * cs]
+template <class T>
+struct matrix_view {
+  T* p;
+  std::size_t rs;
+  std::size_t cs;
+
+  T& operator()(std::size_t i, std::size_t j) const {
+    return p[i * rs + j * cs];
+  }
+};
+
+// packs rows [i0, i0 + mb) and columns [p0, p0 + kb) of A into mr-row
+// micro-panels (column by column, zero padded)
+template <class T>
+void gemm_pack_a(matrix_view<const T> A, std::size_t i0, std::size_t mb,
+                 std::size_t p0, std::size_t kb, T* buf) {
+  const std::size_t MR = gemm_blocking<T>::mr;
+  for (std::size_t ir = 0; ir < mb; ir += MR)
+    for (std::size_t p = 0; p < kb; p++)
+      for (std::size_t i = 0; i < MR; i++)
+        *buf++ = (ir + i < mb) ? A(i0 + ir + i, p0 + p) : T(0);
+}
+
+// packs rows [p0, p0 + kb) and columns [j0, j0 + nb) of B into nr-column
+// micro-panels (row by row, zero padded)
+template <class T>
+void gemm_pack_b(matrix_view<const T> B, std::size_t p0, std::size_t kb,
+                 std::size_t j0, std::size_t nb, T* buf) {
+  const std::size_t NR = gemm_blocking<T>::nr;
+  for (std::size_t jr = 0; jr < nb; jr += NR)
+    for (std::size_t p = 0; p < kb; p++)
+      for (std::size_t j = 0; j < NR; j++)
+        *buf++ = (jr + j < nb) ? B(p0 + p, j0 + jr + j) : T(0);
+}
+
+// (s, c) += a b on an mr x nr tile, for 'kb' steps of packed panels.
+// Only the top-left mb x nb part of the tile is loaded and stored.
+template <class T, bool DD>
+void gemm_micro(std::size_t kb, const T* a, const T* b, matrix_view<T> S,
+                matrix_view<T> E, std::size_t mb, std::size_t nb) {
+  const std::size_t MR = gemm_blocking<T>::mr;
+  const std::size_t NR = gemm_blocking<T>::nr;
+  T s[MR][NR];
+  T c[MR][NR];
+  for (std::size_t i = 0; i < MR; i++)
+    for (std::size_t j = 0; j < NR; j++) {
+      s[i][j] = (i < mb && j < nb) ? S(i, j) : T(0);
+      c[i][j] = (i < mb && j < nb) ? E(i, j) : T(0);
+    }
+  for (std::size_t p = 0; p < kb; p++, a += MR, b += NR) {
+    T bp[NR];  // row of B in registers
+    for (std::size_t j = 0; j < NR; j++) bp[j] = b[j];
+    for (std::size_t i = 0; i < MR; i++) {
+      const T ai = a[i];
+      for (std::size_t j = 0; j < NR; j++) {
+        T h, r;
+        if (DD) {
+          eft::two_prod(ai, bp[j], h, r);
+        } else {
+          h = ai * bp[j];
+          r = 0;
+        }
+        T t = s[i][j] + h;
+        c[i][j] += eft::two_sum_error(s[i][j], h, t) + r;
+        s[i][j] = t;
+      }
+    }
+  }
+  for (std::size_t i = 0; i < mb; i++)
+    for (std::size_t j = 0; j < nb; j++) {
+      S(i, j) = s[i][j];
+      E(i, j) = c[i][j];
+    }
+}
+
+// columns [j0, j1) of C = A B (A is m x k)
+template <class T, bool DD>
+void gemm_cols(std::size_t m, std::size_t k, matrix_view<const T> A,
+               matrix_view<const T> B, matrix_view<T> C, std::size_t j0,
+               std::size_t j1) {
+  typedef gemm_blocking<T> blk;
+  const std::size_t MR = blk::mr;
+  const std::size_t NR = blk::nr;
+  const std::size_t width = j1 - j0;
+  for (std::size_t i = 0; i < m; i++)
+    for (std::size_t j = j0; j < j1; j++) C(i, j) = 0;
+  // errors of this range of C (row-major)
+  std::vector<T> err(m * width, T(0));
+  std::vector<T> pa(blk::mc * blk::kc);
+  std::vector<T> pb(blk::kc * blk::nc);
+  for (std::size_t jc = j0; jc < j1; jc += blk::nc) {
+    const std::size_t nb = (j1 - jc < blk::nc) ? j1 - jc : blk::nc;
+    for (std::size_t pc = 0; pc < k; pc += blk::kc) {
+      const std::size_t kb = (k - pc < blk::kc) ? k - pc : blk::kc;
+      gemm_pack_b(B, pc, kb, jc, nb, pb.data());
+      for (std::size_t ic = 0; ic < m; ic += blk::mc) {
+        const std::size_t mb = (m - ic < blk::mc) ? m - ic : blk::mc;
+        gemm_pack_a(A, ic, mb, pc, kb, pa.data());
+        for (std::size_t jr = 0; jr < nb; jr += NR) {
+          for (std::size_t ir = 0; ir < mb; ir += MR) {
+            matrix_view<T> S = {&C(ic + ir, jc + jr), C.rs, C.cs};
+            matrix_view<T> E = {&err[(ic + ir) * width + (jc - j0 + jr)],
+                                width, 1};
+            gemm_micro<T, DD>(kb, pa.data() + ir * kb, pb.data() + jr * kb, S,
+                              E, (mb - ir < MR) ? mb - ir : MR,
+                              (nb - jr < NR) ? nb - jr : NR);
+          }
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < m; i++)
+    for (std::size_t j = j0; j < j1; j++) C(i, j) += err[i * width + j - j0];
+}
+
+}  // namespace detail
+
+// compensated C = A B: A is m x k, B is k x n and C is m x n (leading
+// dimensions 'lda', 'ldb' and 'ldc', all in the same layout). Columns of C
+// are split over 'threads' threads (0 means 'default_threads()'); results
+// do not depend on the number of threads.
+template <class T>
+void gemm(layout lay, gemm_mode mode, std::size_t m, std::size_t n,
+          std::size_t k, const T* A, std::size_t lda, const T* B,
+          std::size_t ldb, T* C, std::size_t ldc, unsigned threads = 0) {
+  const bool row = (lay == layout::row_major);
+  detail::matrix_view<const T> va = {A, row ? lda : 1, row ? 1 : lda};
+  detail::matrix_view<const T> vb = {B, row ? ldb : 1, row ? 1 : ldb};
+  detail::matrix_view<T> vc = {C, row ? ldc : 1, row ? 1 : ldc};
+  const std::size_t NR = detail::gemm_blocking<T>::nr;
+  const std::size_t tiles = (n + NR - 1) / NR;
+  // about 64K multiply-adds per thread at least
+  const std::size_t work = m * k * NR;
+  const std::size_t min_tiles = (work == 0) ? tiles : (1 << 16) / work + 1;
+  detail::parallel_ranges(
+      tiles, threads, min_tiles,
+      [=](std::size_t t0, std::size_t t1) {
+        const std::size_t j0 = t0 * NR;
+        const std::size_t j1 = (t1 * NR < n) ? t1 * NR : n;
+        if (mode == gemm_mode::double_double)
+          detail::gemm_cols<T, true>(m, k, va, vb, vc, j0, j1);
+        else
+          detail::gemm_cols<T, false>(m, k, va, vb, vc, j0, j1);
+      });
+}
+
+}  // namespace kahan
@@ -0,0 +1,169 @@
+#pragma once
+
+// gemv.hpp: compensated dot product and matrix-vector product
+//
+// Products are split exactly by TwoProduct and sums by TwoSum (Dot2: T.
+// Ogita, S. M. Rump, S. Oishi. Accurate Sum and Dot Product. 2005), so
+// results are as accurate as if computed in twice the working precision:
+// |res - x.y| <= u|x.y| + gamma(n)^2 |x|.|y|
+//
+// Data stays in plain arrays of T (no accumulator objects per element):
+// each output keeps several independent (sum, error) lanes, so the inner
+// loops are branch-free and can be vectorized (use -O3 -mavx2 -mfma).
+
+#include <cstddef>  // size_t
+//
+#include "eft.hpp"       // two_prod, two_sum_error
+#include "parallel.hpp"  // detail::parallel_ranges
+#include "sum.hpp"       // bulk_lanes, detail::fold_partials
+
+namespace kahan {
+
+// storage order of matrices
+enum class layout { row_major, col_major };
+
+namespace detail {
+
+// Dot2 on 'n' elements, accumulated into lanes (p[k], s[k]) of L lanes
+template <class T, std::size_t L>
+void dot2_lanes(const T* x, const T* y, std::size_t n, T* p_io, T* s_io) {
+  // local copies: lanes stay in registers (no aliasing with x, y)
+  T p[L];
+  T s[L];
+  for (std::size_t k = 0; k < L; k++) {
+    p[k] = p_io[k];
+    s[k] = s_io[k];
+  }
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    for (std::size_t k = 0; k < L; k++) {
+      T h, r;
+      eft::two_prod(x[i + k], y[i + k], h, r);
+      T t = p[k] + h;
+      s[k] += eft::two_sum_error(p[k], h, t) + r;
+      p[k] = t;
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    T h, r;
+    eft::two_prod(x[i], y[i], h, r);
+    T t = p[k] + h;
+    s[k] += eft::two_sum_error(p[k], h, t) + r;
+    p[k] = t;
+  }
+  for (std::size_t k = 0; k < L; k++) {
+    p_io[k] = p[k];
+    s_io[k] = s[k];
+  }
+}
+
+// folds lanes into a single (rounded) value
+template <class T, std::size_t L>
+T dot2_fold(const T* p, const T* s) {
+  T fs, fc;
+  fold_partials(p, s, L, fs, fc);
+  return fs + fc;
+}
+
+// gemv blocking: rows per block (row-major and column-major) and columns
+// per block (row-major: a block of 'x' stays in L1 for all rows of a block)
+struct gemv_blocking {
+  static constexpr std::size_t row_block = 16;
+  static constexpr std::size_t col_block = 1024;
+  static constexpr std::size_t col_rows = 256;
+};
+
+// rows [i0, i1) of y = A x, A row-major
+template <class T>
+void gemv_rows(std::size_t i0, std::size_t i1, std::size_t n, const T* A,
+               std::size_t lda, const T* x, T* y) {
+  const std::size_t L = bulk_lanes<T>::value;
+  const std::size_t MB = gemv_blocking::row_block;
+  const std::size_t NB = gemv_blocking::col_block;
+  T p[MB][L];
+  T s[MB][L];
+  for (std::size_t ib = i0; ib < i1; ib += MB) {
+    const std::size_t mb = (i1 - ib < MB) ? i1 - ib : MB;
+    for (std::size_t i = 0; i < mb; i++)
+      for (std::size_t k = 0; k < L; k++) {
+        p[i][k] = 0;
+        s[i][k] = 0;
+      }
+    for (std::size_t jb = 0; jb < n; jb += NB) {
+      const std::size_t nb = (n - jb < NB) ? n - jb : NB;
+      for (std::size_t i = 0; i < mb; i++)
+        dot2_lanes<T, L>(A + (ib + i) * lda + jb, x + jb, nb, p[i], s[i]);
+    }
+    for (std::size_t i = 0; i < mb; i++)
+      y[ib + i] = dot2_fold<T, L>(p[i], s[i]);
+  }
+}
+
+// rows [i0, i1) of y = A x, A column-major (one lane per row)
+template <class T>
+void gemv_cols(std::size_t i0, std::size_t i1, std::size_t n, const T* A,
+               std::size_t lda, const T* x, T* y) {
+  const std::size_t MB = gemv_blocking::col_rows;
+  T p[MB];
+  T s[MB];
+  for (std::size_t ib = i0; ib < i1; ib += MB) {
+    const std::size_t mb = (i1 - ib < MB) ? i1 - ib : MB;
+    for (std::size_t i = 0; i < mb; i++) {
+      p[i] = 0;
+      s[i] = 0;
+    }
+    for (std::size_t j = 0; j < n; j++) {
+      const T* a = A + j * lda + ib;
+      const T xj = x[j];
+      for (std::size_t i = 0; i < mb; i++) {
+        T h, r;
+        eft::two_prod(a[i], xj, h, r);
+        T t = p[i] + h;
+        s[i] += eft::two_sum_error(p[i], h, t) + r;
+        p[i] = t;
+      }
+    }
+    for (std::size_t i = 0; i < mb; i++) y[ib + i] = p[i] + s[i];
+  }
+}
+
+}  // namespace detail
+
+// compensated dot product of 'n' elements of 'x' and 'y' (Dot2)
+template <class T>
+T dot2(const T* x, const T* y, std::size_t n) {
+  const std::size_t L = bulk_lanes<T>::value;
+  T p[L];
+  T s[L];
+  for (std::size_t k = 0; k < L; k++) {
+    p[k] = 0;
+    s[k] = 0;
+  }
+  detail::dot2_lanes<T, L>(x, y, n, p, s);
+  return detail::dot2_fold<T, L>(p, s);
+}
+
+// compensated y = A x: A is m x n (leading dimension 'lda'), x has n and y
+// has m elements. Rows are split over 'threads' threads (0 means
+// 'default_threads()'); small products run on the calling thread.
+template <class T>
+void gemv(layout lay, std::size_t m, std::size_t n, const T* A,
+          std::size_t lda, const T* x, T* y, unsigned threads = 0) {
+  // about 64K multiply-adds per thread at least
+  const std::size_t min_rows = (n == 0) ? m : ((1 << 16) + n - 1) / n;
+  if (lay == layout::row_major) {
+    detail::parallel_ranges(
+        m, threads, min_rows,
+        [n, A, lda, x, y](std::size_t i0, std::size_t i1) {
+          detail::gemv_rows(i0, i1, n, A, lda, x, y);
+        });
+  } else {
+    detail::parallel_ranges(
+        m, threads, min_rows,
+        [n, A, lda, x, y](std::size_t i0, std::size_t i1) {
+          detail::gemv_cols(i0, i1, n, A, lda, x, y);
+        });
+  }
+}
+
+}  // namespace kahan
@@ -0,0 +1,233 @@
+#pragma once
+
+// half.hpp: 16-bit storage (bfloat16, IEEE binary16) with compensated
+// float accumulation
+//
+// bfloat16 and float16 only hold bits: they convert to float (exactly,
+// implicit) and from float (round to nearest even). Bulk kernels widen
+// blocks of inputs into a float buffer on the stack and add them to the
+// lanes of sum.hpp, so no widened copy of the whole input is needed:
+//
+// - bfloat16: a 16-bit shift, vectorized by the compiler
+// - float16: F16C 'vcvtph2ps' (8 at a time) when compiled with -mf16c
+//   (or -march=native), portable bit manipulation otherwise
+//
+// 'bulk_sum<float>(x, n)' over 16-bit inputs is the same sum (same lanes)
+// as over the widened floats.
+
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <cstring>  // memcpy
+//
+#include "neumaier.hpp"  // tneumaier (result type)
+#include "sum.hpp"       // bulk_lanes, detail::add_lanes, fold_partials
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace kahan {
+
+namespace detail {
+
+inline float bits_to_float(std::uint32_t u) {
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+inline std::uint32_t float_to_bits(float f) {
+  std::uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+// IEEE binary16 to float (exact)
+inline float half_to_float(std::uint16_t h) {
+  const std::uint32_t sign = std::uint32_t(h & 0x8000u) << 16;
+  const std::uint32_t exp = (h >> 10) & 0x1fu;
+  std::uint32_t man = h & 0x3ffu;
+  if (exp == 0x1fu)  // inf or nan (quiet, keeps payload as F16C)
+    return bits_to_float(sign | 0x7f800000u | (man ? 0x400000u : 0u) |
+                         (man << 13));
+  if (exp != 0)  // normal
+    return bits_to_float(sign | ((exp + 112) << 23) | (man << 13));
+  if (man == 0) return bits_to_float(sign);  // zero
+  // subnormal: normalize
+  std::uint32_t e = 113;
+  while ((man & 0x400u) == 0) {
+    man <<= 1;
+    e--;
+  }
+  return bits_to_float(sign | (e << 23) | ((man & 0x3ffu) << 13));
+}
+
+// float to IEEE binary16, round to nearest even
+inline std::uint16_t float_to_half(float f) {
+  const std::uint32_t u = float_to_bits(f);
+  const std::uint16_t sign = std::uint16_t((u >> 16) & 0x8000u);
+  const std::uint32_t exp = (u >> 23) & 0xffu;
+  const std::uint32_t man = u & 0x7fffffu;
+  if (exp == 0xffu)  // inf or nan (quiet)
+    return sign | 0x7c00u | (man ? 0x200u | (man >> 13) : 0u);
+  const int e = int(exp) - 112;  // binary16 biased exponent
+  if (e >= 31) return sign | 0x7c00u;  // overflow
+  if (e <= 0) {
+    // subnormal or zero: shift mantissa (with hidden bit) into place
+    if (e < -10) return sign;
+    const std::uint32_t m = man | 0x800000u;
+    const int shift = 14 - e;
+    std::uint32_t h = m >> shift;
+    const std::uint32_t rem = m & ((1u << shift) - 1);
+    const std::uint32_t half = 1u << (shift - 1);
+    if (rem > half || (rem == half && (h & 1u))) h++;
+    return sign | std::uint16_t(h);
+  }
+  std::uint32_t h = (std::uint32_t(e) << 10) | (man >> 13);
+  const std::uint32_t rem = man & 0x1fffu;
+  // may carry into the exponent (up to inf)
+  if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) h++;
+  return sign | std::uint16_t(h);
+}
+
+// float to bfloat16, round to nearest even
+inline std::uint16_t float_to_bfloat(float f) {
+  const std::uint32_t u = float_to_bits(f);
+  if ((u & 0x7fffffffu) > 0x7f800000u)  // nan (quiet)
+    return std::uint16_t((u >> 16) | 0x40u);
+  const std::uint32_t rounding = 0x7fffu + ((u >> 16) & 1u);
+  return std::uint16_t((u + rounding) >> 16);
+}
+
+}  // namespace detail
+
+// =========================================================
+
+// bfloat16 storage (8 exponent bits, 8 significant bits)
+struct bfloat16 {
+  std::uint16_t bits;
+
+  // exact (not 'explicit', may be automatic!)
+  operator float() const {
+    return detail::bits_to_float(std::uint32_t(this->bits) << 16);
+  }
+};
+
+// IEEE binary16 storage (5 exponent bits, 11 significant bits)
+struct float16 {
+  std::uint16_t bits;
+
+  // exact (not 'explicit', may be automatic!)
+  operator float() const {
+#if defined(__F16C__)
+    return _cvtsh_ss(this->bits);
+#else
+    return detail::half_to_float(this->bits);
+#endif
+  }
+};
+
+// rounded to nearest even
+inline bfloat16 to_bfloat16(float f) {
+  bfloat16 b;
+  b.bits = detail::float_to_bfloat(f);
+  return b;
+}
+
+// rounded to nearest even
+inline float16 to_float16(float f) {
+  float16 h;
+  h.bits = detail::float_to_half(f);
+  return h;
+}
+
+// =========================================================
+
+// converts 'n' elements of 'x' to float
+inline void widen(const bfloat16* x, std::size_t n, float* out) {
+  for (std::size_t i = 0; i < n; i++)
+    out[i] = detail::bits_to_float(std::uint32_t(x[i].bits) << 16);
+}
+
+// converts 'n' elements of 'x' to float
+inline void widen(const float16* x, std::size_t n, float* out) {
+  std::size_t i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8) {
+    __m128i h;
+    std::memcpy(&h, x + i, sizeof(h));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < n; i++) out[i] = float(x[i]);
+}
+
+namespace detail {
+
+// lanes over blocks widened on the stack
+template <class T, class H>
+void sum_lanes_half(const H* data, std::size_t n, T& s_out, T& c_out) {
+  const std::size_t L = bulk_lanes<T>::value;
+  const std::size_t B = 256;  // multiple of L: same lanes as one call
+  static_assert(B % bulk_lanes<T>::value == 0, "Expected whole lanes");
+  T s[L];
+  T c[L];
+  for (std::size_t k = 0; k < L; k++) {
+    s[k] = 0;
+    c[k] = 0;
+  }
+  float buf[B];
+  for (std::size_t i = 0; i < n; i += B) {
+    const std::size_t b = (n - i < B) ? n - i : B;
+    widen(data + i, b, buf);
+    add_lanes(buf, b, s, c);
+  }
+  fold_partials(s, c, L, s_out, c_out);
+}
+
+}  // namespace detail
+
+// compensated sum of 'n' 16-bit elements (value and pending correction)
+template <class T>
+tneumaier<T, neumaier_branchless> bulk_sum(const bfloat16* data,
+                                           std::size_t n) {
+  T s, c;
+  detail::sum_lanes_half(data, n, s, c);
+  return tneumaier<T, neumaier_branchless>(s, c);
+}
+
+template <class T>
+tneumaier<T, neumaier_branchless> bulk_sum(const float16* data,
+                                           std::size_t n) {
+  T s, c;
+  detail::sum_lanes_half(data, n, s, c);
+  return tneumaier<T, neumaier_branchless>(s, c);
+}
+
+// adds 'n' 16-bit elements to any accumulator (using bulk kernel)
+template <class Acc>
+Acc& bulk_add(Acc& acc, const bfloat16* data, std::size_t n) {
+  decltype(acc.getValue()) s, c;
+  detail::sum_lanes_half(data, n, s, c);
+  acc += s;
+  acc += c;
+  return acc;
+}
+
+template <class Acc>
+Acc& bulk_add(Acc& acc, const float16* data, std::size_t n) {
+  decltype(acc.getValue()) s, c;
+  detail::sum_lanes_half(data, n, s, c);
+  acc += s;
+  acc += c;
+  return acc;
+}
+
+// =========================================================
+
+struct half_helper {
+  static_assert(sizeof(bfloat16) == 2, "Expected 2 bytes on bfloat16");
+  static_assert(sizeof(float16) == 2, "Expected 2 bytes on float16");
+};
+
+}  // namespace kahan
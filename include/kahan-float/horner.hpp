@@ -0,0 +1,78 @@
+#pragma once
+
+// horner.hpp: compensated Horner polynomial evaluation
+//
+// Coefficients are given in increasing degree: p(x) = a[0] + a[1]*x + ...
+// + a[n-1]*x^(n-1) (n coefficients, degree n-1).
+//
+// comp_horner: S. Graillat, Ph. Langlois, N. Louvet. Compensated Horner
+// Scheme. 2005. Result is as accurate as if computed in twice the working
+// precision, then rounded: |res - p(x)| <= u|p(x)| + gamma(2n)^2 cond(p,x)
+
+#include <cstddef>  // size_t
+//
+#include "eft.hpp"  // two_sum, two_prod
+
+namespace kahan {
+
+// plain Horner scheme (for reference)
+template <class T>
+T horner(const T* a, std::size_t n, T x) {
+  if (n == 0) return T(0);
+  T r = a[n - 1];
+  for (std::size_t i = n - 1; i > 0; i--) r = r * x + a[i - 1];
+  return r;
+}
+
+// compensated Horner scheme (CompHorner)
+template <class T>
+T comp_horner(const T* a, std::size_t n, T x) {
+  if (n == 0) return T(0);
+  T s = a[n - 1];
+  T c = 0;  // Horner on the errors of each step
+  for (std::size_t i = n - 1; i > 0; i--) {
+    T p, pi, sigma;
+    eft::two_prod(s, x, p, pi);
+    eft::two_sum(p, a[i - 1], s, sigma);
+    c = c * x + (pi + sigma);
+  }
+  return s + c;
+}
+
+// batch version: evaluates one polynomial on 'm' points 'x', into 'out'.
+// Points are processed in groups of 'lanes', one lane per point, so the
+// inner loop runs the same step over independent points (SIMD friendly).
+template <class T>
+void comp_horner(const T* a, std::size_t n, const T* x, T* out,
+                 std::size_t m) {
+  const std::size_t lanes = 16;
+  if (n == 0) {
+    for (std::size_t j = 0; j < m; j++) out[j] = T(0);
+    return;
+  }
+  std::size_t j = 0;
+  for (; j + lanes <= m; j += lanes) {
+    T s[lanes];
+    T c[lanes];
+    for (std::size_t k = 0; k < lanes; k++) {
+      s[k] = a[n - 1];
+      c[k] = 0;
+    }
+    for (std::size_t i = n - 1; i > 0; i--) {
+      const T ai = a[i - 1];
+      for (std::size_t k = 0; k < lanes; k++) {
+        T p, pi;
+        eft::two_prod(s[k], x[j + k], p, pi);
+        T sk = p + ai;
+        T sigma = eft::two_sum_error(p, ai, sk);
+        c[k] = c[k] * x[j + k] + (pi + sigma);
+        s[k] = sk;
+      }
+    }
+    for (std::size_t k = 0; k < lanes; k++) out[j + k] = s[k] + c[k];
+  }
+  // remaining points
+  for (; j < m; j++) out[j] = comp_horner(a, n, x[j]);
+}
+
+}  // namespace kahan
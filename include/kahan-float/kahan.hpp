@@ -9,6 +9,9 @@
 #include <iostream>
 #include <limits>   // numeric_limits (will extend this below)
 #include <utility>  // declval
+//
+#include "eft.hpp"        // fast_two_sum
+#include "telemetry.hpp"  // KAHAN_TELEMETRY_STEP
 
 namespace kahan {
 
@@ -43,14 +46,18 @@ struct tkahan {
 
   // copy assignment (for any valid element)
   template <class X>
-  tkahan<T>& operator+=(const X& add) {
+  tkahan<T>& operator+=(const X& _add) {
+    T add = static_cast<T>(_add);  // converting to correct type
+    //
     // naive solution
     // this->val += add;  // will accumulate errors easily
     //
     // kahan operation
     T y = add - this->c;
     T t = this->val + y;
-    this->c = (t - this->val) - y;
+    // 'c' is minus the FastTwoSum error (assumes |val| >= |y|)
+    this->c = -eft::fast_two_sum_error(this->val, y, t);
+    KAHAN_TELEMETRY_STEP(this->val, add, t, this->c, true);
     this->val = t;
     // we must ensure that 'c' is never 'contaminated' by 'nan'
     // TODO: verify that this is REALLY safe... looks like.
@@ -59,6 +66,14 @@ struct tkahan {
     return *this;
   }
 
+  // adds value and pending correction of 'other' (same as 'merge')
+  tkahan<T>& operator+=(const tkahan<T>& other) {
+    const tkahan<T> o(other);  // 'other' may be '*this'
+    (*this) += o.val;
+    (*this) += -o.c;  // kahan 'c' is minus the lost digits
+    return *this;
+  }
+
   // reverse (unary minus)
   tkahan<T> operator-() const { return tkahan<T>(-this->val, -this->c); }
 
@@ -142,7 +157,7 @@ struct kahan_helper {
 // UTILS
 
 // print variable bits (MSB to LSB) -> Big Endian bitstring format
-void kprint_bin(int val, int sz) {
+inline void kprint_bin(int val, int sz) {
   for (int k = sz - 1; k >= 0; k--) {
     if ((val >> k) & 1)
       printf("1");
@@ -169,7 +184,7 @@ typedef union {
   } data_f;
 } union_float32;
 
-void print_IEEE754(float f32) {
+inline void print_IEEE754(float f32) {
   union_float32 var;
   var.f = f32;
   //
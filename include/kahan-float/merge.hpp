@@ -0,0 +1,53 @@
+#pragma once
+
+// merge.hpp: combines two partial accumulators into one
+//
+// 'merge' adds the full state of 'other', so merging partials computed
+// apart (threads, processes, checkpoints) keeps all digits carried by the
+// corrections. For tkahan and tneumaier of the same type, 'acc += other'
+// and 'acc + other' do the same; across types only the value of 'other' is
+// added, rounded to T (its pending correction is lost).
+
+#include <cmath>    // isnan
+#include <cstddef>  // size_t
+#include <limits>
+//
+#include "fsum.hpp"      // tshewchuk
+#include "kahan.hpp"     // tkahan
+#include "neumaier.hpp"  // tneumaier
+
+namespace kahan {
+
+template <class T>
+tkahan<T>& merge(tkahan<T>& acc, const tkahan<T>& other) {
+  acc += other.getValue();
+  acc += -other.getC();  // kahan 'c' is minus the lost digits
+  return acc;
+}
+
+template <class T, class Step>
+tneumaier<T, Step>& merge(tneumaier<T, Step>& acc,
+                          const tneumaier<T, Step>& other) {
+  acc += other.getRawValue();
+  acc += other.getC();
+  return acc;
+}
+
+// exact: all partials, overflow units and non-finite inputs are added
+template <class T, std::size_t N>
+tshewchuk<T, N>& merge(tshewchuk<T, N>& acc, const tshewchuk<T, N>& other) {
+  for (std::size_t i = 0; i < other.size(); i++) acc += other.partial(i);
+  acc.add_units(other.getOverflow());
+  const T inf = std::numeric_limits<T>::infinity();
+  if (std::isnan(other.getInf())) {
+    acc += inf;  // inf - inf
+    acc += -inf;
+  } else if (other.getInf() != 0) {
+    acc += other.getInf();
+  }
+  if (std::isnan(other.getSpecial()) && !std::isnan(other.getInf()))
+    acc += std::numeric_limits<T>::quiet_NaN();
+  return acc;
+}
+
+}  // namespace kahan
@@ -0,0 +1,106 @@
+#pragma once
+
+// mixed.hpp: mixed-precision bulk sums
+//
+// float inputs into double state need nothing special: 'bulk_sum<double>'
+// and 'bulk_add' (sum.hpp) convert each element in registers, so columns
+// can stay float (half the bandwidth) with double-level accuracy.
+//
+// double inputs into float state lose up to half an ulp of float on each
+// element when cast. 'bulk_sum_narrow' splits each input exactly into
+// hi = float(x) and lo = float(x - hi): hi goes to the float lanes and lo
+// to their corrections, so about 48 bits of each input are kept, and what
+// is still left out (x - hi - lo, exact in double) is summed in double and
+// reported as 'lost'.
+
+#include <cstddef>  // size_t
+//
+#include "eft.hpp"       // two_sum_error
+#include "neumaier.hpp"  // tneumaier (result type)
+#include "sum.hpp"       // bulk_lanes, detail::fold_partials
+
+namespace kahan {
+
+namespace detail {
+
+// float lanes over double inputs: s[k], c[k] as in 'add_lanes', r[k] the
+// double residuals
+inline void narrow_lanes(const double* data, std::size_t n, float* s_io,
+                         float* c_io, double* r_io) {
+  const std::size_t L = bulk_lanes<float>::value;
+  float s[L];  // locals: no aliasing with 'data'
+  float c[L];
+  double r[L];
+  for (std::size_t k = 0; k < L; k++) {
+    s[k] = s_io[k];
+    c[k] = c_io[k];
+    r[k] = r_io[k];
+  }
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    for (std::size_t k = 0; k < L; k++) {
+      const double x = data[i + k];
+      const float hi = static_cast<float>(x);
+      const double d = x - hi;  // exact
+      const float lo = static_cast<float>(d);
+      r[k] += d - lo;  // exact residual
+      float t = s[k] + hi;
+      c[k] += eft::two_sum_error(s[k], hi, t) + lo;
+      s[k] = t;
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    const double x = data[i];
+    const float hi = static_cast<float>(x);
+    const double d = x - hi;
+    const float lo = static_cast<float>(d);
+    r[k] += d - lo;
+    float t = s[k] + hi;
+    c[k] += eft::two_sum_error(s[k], hi, t) + lo;
+    s[k] = t;
+  }
+  for (std::size_t k = 0; k < L; k++) {
+    s_io[k] = s[k];
+    c_io[k] = c[k];
+    r_io[k] = r[k];
+  }
+}
+
+}  // namespace detail
+
+// compensated float sum of 'n' double elements of 'data'. 'lost' is set to
+// the sum of the parts of the inputs not representable by the float pair
+// (not finite if some input overflows float).
+inline tneumaier<float, neumaier_branchless> bulk_sum_narrow(
+    const double* data, std::size_t n, double& lost) {
+  const std::size_t L = bulk_lanes<float>::value;
+  float s[L];
+  float c[L];
+  double r[L];
+  for (std::size_t k = 0; k < L; k++) {
+    s[k] = 0;
+    c[k] = 0;
+    r[k] = 0;
+  }
+  detail::narrow_lanes(data, n, s, c, r);
+  float fs, fc;
+  detail::fold_partials(s, c, L, fs, fc);
+  lost = 0;
+  for (std::size_t k = 0; k < L; k++) lost += r[k];
+  return tneumaier<float, neumaier_branchless>(fs, fc);
+}
+
+// adds 'n' double elements to a float accumulator (using bulk kernel), and
+// adds the parts left out to 'lost'
+template <class Acc>
+Acc& bulk_add_narrow(Acc& acc, const double* data, std::size_t n,
+                     double& lost) {
+  double l;
+  tneumaier<float, neumaier_branchless> part = bulk_sum_narrow(data, n, l);
+  acc += part.getRawValue();
+  acc += part.getC();
+  lost += l;
+  return acc;
+}
+
+}  // namespace kahan
@@ -0,0 +1,99 @@
+#pragma once
+
+// mmap.hpp: compensated summation of raw binary files (POSIX only)
+//
+// Files are plain arrays of float or double in native byte order (as written
+// by 'fwrite' or numpy 'tofile'). They are memory-mapped read-only, with
+// sequential access (and huge pages, where supported) hints, and reduced by
+// 'parallel_sum' without copying data into vectors.
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+
+#include <cerrno>   // errno
+#include <cstddef>  // size_t
+//
+#include "parallel.hpp"  // parallel_sum
+
+namespace kahan {
+
+// read-only file mapping (closed on destruction)
+class mapped_file {
+ private:
+  void* addr{nullptr};
+  std::size_t len{0};
+
+ public:
+  mapped_file() {}
+
+  // see 'open'
+  explicit mapped_file(const char* path) { open(path); }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file() { close(); }
+
+  // maps whole file; returns false on failure (see 'errno')
+  bool open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    len = static_cast<std::size_t>(st.st_size);
+    if (len > 0) {
+      void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        len = 0;
+        return false;
+      }
+      addr = p;
+      // hints only: failures are not errors
+      ::madvise(addr, len, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+      ::madvise(addr, len, MADV_HUGEPAGE);
+#endif
+    }
+    ::close(fd);  // mapping stays valid
+    return true;
+  }
+
+  void close() {
+    if (addr) ::munmap(addr, len);
+    addr = nullptr;
+    len = 0;
+  }
+
+  bool is_open() const { return addr != nullptr; }
+
+  const void* data() const { return addr; }
+
+  // size in bytes
+  std::size_t size() const { return len; }
+};
+
+// compensated sum of a binary file of X (float or double), accumulated in T
+// returns false if file could not be mapped (see 'errno') or its size is not
+// a multiple of sizeof(X) (errno is EINVAL); an empty file sums to zero
+template <class T, class X>
+bool sum_file(const char* path, tneumaier<T, neumaier_branchless>& result,
+              unsigned threads = 0) {
+  mapped_file f;
+  if (!f.open(path)) return false;
+  if (f.size() % sizeof(X) != 0) {
+    errno = EINVAL;
+    return false;
+  }
+  const X* data = static_cast<const X*>(f.data());
+  result = parallel_sum<T>(data, f.size() / sizeof(X), threads);
+  return true;
+}
+
+}  // namespace kahan
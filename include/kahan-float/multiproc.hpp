@@ -0,0 +1,208 @@
+#pragma once
+
+// multiproc.hpp: multi-process reduction over shared memory (POSIX only)
+//
+// Each worker process computes a partial accumulator, which is serialized
+// into its slot of a shared memory segment. Partials are then combined by a
+// binary tree of workers: at step s (1, 2, 4, ...), rank r (multiple of 2s)
+// merges the result of rank r + s into its own. The tree only depends on the
+// number of workers, so results are reproducible, whatever the scheduling.
+//
+// This simulates cluster nodes on a single box: slots are the messages, and
+// the serialized record format is the same one used for checkpoints.
+//
+// Processes are created with 'fork': the caller should not have other
+// threads running, and workers only see data allocated before the call.
+//
+// Each slot holds 'record_size' bytes ('process_slot_size' by default: a
+// tshewchuk<double> record with up to 124 partials). A worker whose record
+// does not fit fails the reduction with errno EMSGSIZE.
+
+#include <sched.h>     // sched_yield
+#include <sys/mman.h>  // mmap
+#include <sys/wait.h>  // waitpid
+#include <unistd.h>    // fork, _exit, usleep
+
+#include <atomic>
+#include <cerrno>   // errno
+#include <cstddef>  // size_t
+#include <new>      // placement new
+#include <vector>
+//
+#include "merge.hpp"      // merge
+#include "parallel.hpp"   // default_threads
+#include "serialize.hpp"  // serialize, deserialize
+#include "sum.hpp"        // bulk_sum
+
+namespace kahan {
+
+// default bytes reserved for the record of each worker
+constexpr std::size_t process_slot_size = 1024;
+
+namespace detail {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "Expected lock-free (address-free) atomics for shared memory");
+
+// one slot per worker (on its own cache lines), followed by its record
+struct alignas(64) process_slot {
+  // 1 when 'record' holds the result of the subtree of this rank
+  std::atomic<int> ready;
+  // errno of a failed worker (0 if unknown)
+  std::atomic<int> error;
+
+  unsigned char* record() { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+// shared segment header (followed by one slot per worker)
+struct alignas(64) process_segment {
+  // set by parent when some worker failed (others stop waiting)
+  std::atomic<int> abort;
+  // bytes of each record
+  std::size_t record_size;
+
+  process_slot* slot(unsigned rank) {
+    unsigned char* first = reinterpret_cast<unsigned char*>(this + 1);
+    return reinterpret_cast<process_slot*>(
+        first + rank * slot_stride(this->record_size));
+  }
+
+  static std::size_t slot_stride(std::size_t record_size) {
+    const std::size_t a = alignof(process_slot);
+    return sizeof(process_slot) + (record_size + a - 1) / a * a;
+  }
+};
+
+inline std::size_t process_segment_size(unsigned workers,
+                                        std::size_t record_size) {
+  return sizeof(process_segment) +
+         workers * process_segment::slot_stride(record_size);
+}
+
+// waits until 'rank' is ready; returns false on abort
+inline bool process_wait(process_segment* seg, unsigned rank) {
+  while (seg->slot(rank)->ready.load(std::memory_order_acquire) == 0) {
+    if (seg->abort.load(std::memory_order_relaxed)) return false;
+    ::sched_yield();
+  }
+  return true;
+}
+
+// body of worker 'rank'; returns process exit code
+template <class Acc, class Work>
+int process_worker(process_segment* seg, unsigned rank, unsigned workers,
+                   Work& work) {
+  process_slot* slot = seg->slot(rank);
+  Acc acc;
+  work(rank, acc);
+  for (unsigned s = 1; s < workers && rank % (2 * s) == 0; s *= 2) {
+    if (rank + s >= workers) continue;
+    if (!process_wait(seg, rank + s)) return 2;
+    Acc other;
+    if (!deserialize(seg->slot(rank + s)->record(), seg->record_size,
+                     other)) {
+      slot->error.store(EINVAL);
+      return 1;
+    }
+    merge(acc, other);
+  }
+  if (!serialize(acc, slot->record(), seg->record_size)) {
+    slot->error.store(EMSGSIZE);  // record does not fit
+    return 1;
+  }
+  slot->ready.store(1, std::memory_order_release);
+  return 0;
+}
+
+}  // namespace detail
+
+// runs 'workers' processes (0 means 'default_threads()'); worker 'rank'
+// calls 'work(rank, acc)' on an empty 'Acc', and all partials are merged
+// into 'result' (see above). Returns false if the shared segment or a
+// process could not be created (see 'errno'), or if a worker failed: errno
+// is then EMSGSIZE if a record did not fit in 'record_size' bytes, EINVAL
+// if a record was invalid, and ECHILD otherwise (e.g. a crash).
+template <class Acc, class Work>
+bool process_reduce(unsigned workers, Work work, Acc& result,
+                    std::size_t record_size = process_slot_size) {
+  if (workers == 0) workers = default_threads();
+  const std::size_t len = detail::process_segment_size(workers, record_size);
+  void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return false;
+  detail::process_segment* seg = new (p) detail::process_segment;
+  seg->abort.store(0);
+  seg->record_size = record_size;
+  for (unsigned r = 0; r < workers; r++) {
+    detail::process_slot* slot = new (seg->slot(r)) detail::process_slot;
+    slot->ready.store(0);
+    slot->error.store(0);
+  }
+
+  std::vector<pid_t> pids;
+  bool ok = true;
+  for (unsigned r = 0; r < workers; r++) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      // child: no destructors, no stdio flush (parent state is shared)
+      ::_exit(detail::process_worker<Acc>(seg, r, workers, work));
+    }
+    if (pid < 0) {
+      ok = false;
+      break;
+    }
+    pids.push_back(pid);
+  }
+  int err = errno;
+  if (!ok) seg->abort.store(1);
+
+  // polls all workers: a failed one (or a crash) aborts all others
+  std::size_t running = pids.size();
+  while (running > 0) {
+    bool progress = false;
+    for (std::size_t i = 0; i < pids.size(); i++) {
+      if (pids[i] == 0) continue;
+      int status;
+      pid_t pid = ::waitpid(pids[i], &status, WNOHANG);
+      if (pid == 0) continue;
+      if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        const int e = seg->slot(unsigned(i))->error.load();
+        if (ok) err = (e != 0) ? e : ECHILD;
+        ok = false;
+        seg->abort.store(1);
+      }
+      pids[i] = 0;
+      running--;
+      progress = true;
+    }
+    if (!progress) ::usleep(100);
+  }
+
+  if (ok) {
+    ok = deserialize(seg->slot(0)->record(), record_size, result) != 0;
+    if (!ok) err = EINVAL;
+  }
+  ::munmap(p, len);
+  if (!ok) errno = err;
+  return ok;
+}
+
+// compensated sum of 'n' elements of 'data', split over 'workers' processes
+template <class T, class X>
+bool process_sum(const X* data, std::size_t n,
+                 tneumaier<T, neumaier_branchless>& result,
+                 unsigned workers = 0) {
+  if (workers == 0) workers = default_threads();
+  const std::size_t chunk = n / workers;
+  return process_reduce(
+      workers,
+      [data, n, chunk, workers](unsigned rank,
+                                tneumaier<T, neumaier_branchless>& acc) {
+        const std::size_t begin = std::size_t(rank) * chunk;
+        const std::size_t count = (rank == workers - 1) ? n - begin : chunk;
+        acc = bulk_sum<T>(data + begin, count);
+      },
+      result);
+}
+
+}  // namespace kahan
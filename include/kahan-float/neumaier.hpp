@@ -6,10 +6,46 @@
 #include <iostream>
 #include <limits>   // numeric_limits (will extend this below)
 #include <utility>  // declval
+//
+#include "eft.hpp"        // two_sum, fast_two_sum
+#include "telemetry.hpp"  // KAHAN_TELEMETRY_STEP
 
 namespace kahan {
 
-template <class T>
+// =========================================================
+// compensation step policies for tneumaier
+// ---------------------------------------------------------
+// both return the rounding error of 's = a + b'
+
+// Neumaier original: magnitude compare picks which digits were lost
+// (3 flops, but branch mispredicts on mixed-magnitude data)
+struct neumaier_branching {
+  // 'nan' is cleaned from correction on every add
+  static constexpr bool lazy_nan = false;
+
+  template <class T>
+  static T error(T a, T b, T s) {
+    if (::fabs(a) >= ::fabs(b))
+      return eft::fast_two_sum_error(a, b, s);  // low-order digits of b lost
+    else
+      return eft::fast_two_sum_error(b, a, s);  // low-order digits of a lost
+  }
+};
+
+// Knuth TwoSum: same error for any magnitudes (6 flops, no compare)
+struct neumaier_branchless {
+  // 'nan' is cleaned from correction only on read, keeping the compare off
+  // the dependency chain of 'c' (it only happens after 'val' is inf/nan,
+  // which is sticky, so the result is the same)
+  static constexpr bool lazy_nan = true;
+
+  template <class T>
+  static T error(T a, T b, T s) {
+    return eft::two_sum_error(a, b, s);
+  }
+};
+
+template <class T, class Step = neumaier_branching>
 struct tneumaier {
  private:
   // "real" value
@@ -19,8 +55,8 @@ struct tneumaier {
 
  public:
   // this constructor allows promotion of kahan types
-  template <class T2>
-  constexpr tneumaier(tneumaier<T2> kother) : val(kother.getValue()) {}
+  template <class T2, class Step2>
+  constexpr tneumaier(tneumaier<T2, Step2> kother) : val(kother.getValue()) {}
 
   // build with T value (not 'explicit', may be automatic!)
   constexpr tneumaier(T _val) : val(_val) {}
@@ -34,21 +70,25 @@ struct tneumaier {
   T getValue() const {
     // this->val += this->c;
     // this->c = 0;
-    return this->val + this->c;
+    return this->sum();
   }
 
- private:
-  // TODO: do we need this?
-  T getC() const { return this->c; }
+  // value without pending correction
+  T getRawValue() const { return this->val; }
+
+  // pending correction (not yet folded into value)
+  T getC() const {
+    if (Step::lazy_nan) return std::isnan(this->c) ? T(0) : this->c;
+    return this->c;
+  }
 
- public:
   // IMPORTANT: this CHANGES value! lazy operation.
-  explicit operator T() const { return this->val + this->c; }
+  explicit operator T() const { return this->sum(); }
 
   // copy assignment (for any valid element)
   template <class X>
-  tneumaier<T>& operator+=(const X& _add) {
-    T add = _add;  // converting to correct type
+  tneumaier<T, Step>& operator+=(const X& _add) {
+    T add = static_cast<T>(_add);  // converting to correct type
     //
     // naive solution
     // this->val += add;  // will accumulate errors easily
@@ -61,31 +101,36 @@ struct tneumaier {
     // # Math. Mechanik, 54:39–51, 1974.
     //
     T t = this->val + add;
-    if (::fabs(this->val) >= ::fabs(add)) {
-      this->c +=
-          ((this->val - t) +
-           add);  // If sum is bigger, low-order digits of input[i] are lost.
-    } else {
-      this->c +=
-          ((add - t) + this->val);  // Else low-order digits of sum are lost.
-    }
+    this->c += Step::error(this->val, add, t);
+    KAHAN_TELEMETRY_STEP(this->val, add, t, this->c, !Step::lazy_nan);
     this->val = t;
 
     // we must ensure that 'c' is never 'contaminated' by 'nan'
     // TODO: verify that this is REALLY safe... looks like.
-    this->c = std::isnan(this->c) ? 0.0 : this->c;  // TODO:
+    if (!Step::lazy_nan)
+      this->c = std::isnan(this->c) ? 0.0 : this->c;  // TODO:
     //
     return *this;
   }
 
+  // adds value and pending correction of 'other' (same as 'merge')
+  tneumaier<T, Step>& operator+=(const tneumaier<T, Step>& other) {
+    const tneumaier<T, Step> o(other);  // 'other' may be '*this'
+    (*this) += o.val;
+    (*this) += o.getC();
+    return *this;
+  }
+
   // reverse (unary minus)
-  tneumaier<T> operator-() const { return tneumaier<T>(-this->val, -this->c); }
+  tneumaier<T, Step> operator-() const {
+    return tneumaier<T, Step>(-this->val, -this->c);
+  }
 
   // ------------------
 
   // copy assignment (for any valid element)
   template <class X>
-  tneumaier<T>& operator-=(const X& add) {
+  tneumaier<T, Step>& operator-=(const X& add) {
     (*this) += -add;  // reuse '+='
     return *this;
   }
@@ -94,53 +139,62 @@ struct tneumaier {
 
   // copy return (for any valid element)
   template <class X>
-  friend tneumaier<T> operator+(tneumaier<T> lhs, const X& rhs) {
+  friend tneumaier<T, Step> operator+(tneumaier<T, Step> lhs, const X& rhs) {
     lhs += rhs;  // reuse '+='
     return lhs;
   }
 
   // copy return (for any valid element)
   template <class X>
-  friend tneumaier<T> operator-(tneumaier<T> lhs, const X& rhs) {
+  friend tneumaier<T, Step> operator-(tneumaier<T, Step> lhs, const X& rhs) {
     lhs += -rhs;  // reuse '+='
     return lhs;
   }
 
   // ==================
 
-  bool operator==(const tneumaier<T>& other) const {
+  bool operator==(const tneumaier<T, Step>& other) const {
     // since do not cache updated values, we should compare sums here
-    return (this->val + this->c == other.val + other.c);
+    return (this->sum() == other.sum());
   }
 
-  bool operator!=(const tneumaier<T>& other) const {
+  bool operator!=(const tneumaier<T, Step>& other) const {
     return !((*this) == other);
   }
 
-  bool operator<(const tneumaier<T>& other) const {
+  bool operator<(const tneumaier<T, Step>& other) const {
     // time to use accumulator 'c'
-    return (this->val + this->c) < (other.val + other.c);
+    return this->sum() < other.sum();
   }
 
-  bool operator>(const tneumaier<T>& other) const {
+  bool operator>(const tneumaier<T, Step>& other) const {
     // time to use accumulator 'c'
-    return (this->val + this->c) > (other.val + other.c);
+    return this->sum() > other.sum();
   }
 
-  bool operator<=(const tneumaier<T>& other) const {
-    return (this->val + this->c) <= (other.val + other.c);
+  bool operator<=(const tneumaier<T, Step>& other) const {
+    return this->sum() <= other.sum();
   }
 
-  bool operator>=(const tneumaier<T>& other) const {
-    return (this->val + this->c) >= (other.val + other.c);
+  bool operator>=(const tneumaier<T, Step>& other) const {
+    return this->sum() >= other.sum();
   }
 
   // ==================
 
-  friend std::ostream& operator<<(std::ostream& os, const tneumaier<T>& k) {
-    os << (k.val + k.c);
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const tneumaier<T, Step>& k) {
+    os << k.sum();
     return os;
   }
+
+ private:
+  // value with folded correction ('c' may only be 'nan' on lazy_nan steps)
+  T sum() const {
+    if (Step::lazy_nan)
+      return this->val + (std::isnan(this->c) ? T(0) : this->c);
+    return this->val + this->c;
+  }
 };
 
 // =========================================================
@@ -149,6 +203,11 @@ using nfloat32 = tneumaier<float>;
 using nfloat64 = tneumaier<double>;
 using nfloat128 = tneumaier<long double>;
 
+// branchless variants (better for unpredictable magnitudes and signs)
+using nbfloat32 = tneumaier<float, neumaier_branchless>;
+using nbfloat64 = tneumaier<double, neumaier_branchless>;
+using nbfloat128 = tneumaier<long double, neumaier_branchless>;
+
 // =========================================================
 
 // Testing type sizes
@@ -157,6 +216,7 @@ struct neumaier_helper {
   static_assert(sizeof(nfloat32) == 8, "Expected 8 bytes on nfloat32");
   static_assert(sizeof(nfloat64) == 16, "Expected 16 bytes on nfloat64");
   static_assert(sizeof(nfloat128) == 32, "Expected 32 bytes on nfloat64");
+  static_assert(sizeof(nbfloat64) == 16, "Expected 16 bytes on nbfloat64");
 };
 
 }  // namespace kahan
@@ -0,0 +1,192 @@
+#pragma once
+
+// norm.hpp: compensated sum of squares and Euclidean norm
+//
+// Squares are split exactly by TwoProduct and summed by TwoSum (see
+// gemv.hpp), and the square root is corrected by one Newton step on the
+// (sum, error) pair, so norms are accurate to about one ulp for any length.
+//
+// norm2 never overflows or underflows in intermediate squares: when some
+// |x| is outside [tsml, tbig], it falls back to Blue's algorithm with three
+// scaled accumulators (J. L. Blue. A Portable Fortran Program to Find the
+// Euclidean Norm of a Vector. 1978; E. Anderson. Algorithm 978: Safe
+// Scaling in the Level 1 BLAS. 2017, as in LAPACK 'dnrm2').
+
+#include <cmath>    // sqrt, fma, ldexp, fabs
+#include <cstddef>  // size_t
+#include <limits>
+//
+#include "eft.hpp"   // two_prod, two_sum_error
+#include "gemv.hpp"  // detail::dot2_lanes
+#include "sum.hpp"   // bulk_lanes, detail::fold_partials
+
+namespace kahan {
+
+namespace detail {
+
+// Blue's thresholds and scaling factors (powers of 2, exact)
+template <class T>
+struct blue_constants {
+  typedef std::numeric_limits<T> lim;
+  // squares of values in [tsml, tbig] never underflow nor overflow:
+  // ceil((min_exponent - 1) / 2), floor((max_exponent - digits + 1) / 2)
+  static T tsml() { return std::ldexp(T(1), (lim::min_exponent - 1) / 2); }
+  static T tbig() {
+    return std::ldexp(T(1), (lim::max_exponent - lim::digits + 1) / 2);
+  }
+  // scale up small values: -floor((min_exponent - digits) / 2)
+  static T ssml() {
+    return std::ldexp(T(1), (lim::digits - lim::min_exponent + 1) / 2);
+  }
+  // scale down big values: -ceil((max_exponent + digits - 1) / 2)
+  static T sbig() {
+    return std::ldexp(T(1), -((lim::max_exponent + lim::digits) / 2));
+  }
+};
+
+// compensated accumulator of squares
+template <class T>
+struct sumsq_acc {
+  T s{0};
+  T c{0};
+
+  // adds v^2
+  void add(T v) {
+    T h, r;
+    eft::two_prod(v, v, h, r);
+    T t = this->s + h;
+    this->c += eft::two_sum_error(this->s, h, t) + r;
+    this->s = t;
+  }
+
+  // adds v (already a square)
+  void add_sq(T v) {
+    T t = this->s + v;
+    this->c += eft::two_sum_error(this->s, v, t);
+    this->s = t;
+  }
+
+  T value() const { return this->s + this->c; }
+};
+
+// sqrt(s + c), corrected by one Newton step
+template <class T>
+T sqrt2(T s, T c) {
+  T r = std::sqrt(s);
+  if (!(r > 0) || !std::isfinite(r)) return r;  // zero, inf or nan
+  return r + (std::fma(-r, r, s) + c) / (2 * r);
+}
+
+// max and min non-zero of |x| (lanes, vectorizable)
+template <class T>
+void abs_range(const T* x, std::size_t n, T& amin, T& amax) {
+  const std::size_t L = bulk_lanes<T>::value;
+  const T inf = std::numeric_limits<T>::infinity();
+  T lo[L];
+  T hi[L];
+  for (std::size_t k = 0; k < L; k++) {
+    lo[k] = inf;
+    hi[k] = 0;
+  }
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    for (std::size_t k = 0; k < L; k++) {
+      T ax = std::fabs(x[i + k]);
+      T nz = (ax == 0) ? inf : ax;
+      lo[k] = (nz < lo[k]) ? nz : lo[k];
+      hi[k] = (ax > hi[k]) ? ax : hi[k];
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    T ax = std::fabs(x[i]);
+    T nz = (ax == 0) ? inf : ax;
+    lo[k] = (nz < lo[k]) ? nz : lo[k];
+    hi[k] = (ax > hi[k]) ? ax : hi[k];
+  }
+  amin = lo[0];
+  amax = hi[0];
+  for (std::size_t k = 1; k < L; k++) {
+    amin = (lo[k] < amin) ? lo[k] : amin;
+    amax = (hi[k] > amax) ? hi[k] : amax;
+  }
+}
+
+// Blue's algorithm on compensated accumulators (scalar, any magnitudes)
+template <class T>
+T norm2_blue(const T* x, std::size_t n) {
+  typedef blue_constants<T> b;
+  const T tsml = b::tsml(), tbig = b::tbig();
+  const T ssml = b::ssml(), sbig = b::sbig();
+  sumsq_acc<T> asml, amed, abig;
+  bool notbig = true;
+  for (std::size_t i = 0; i < n; i++) {
+    T ax = std::fabs(x[i]);
+    if (ax > tbig) {
+      abig.add(ax * sbig);
+      notbig = false;
+    } else if (ax < tsml) {
+      if (notbig) asml.add(ax * ssml);
+    } else {
+      amed.add(ax);  // also nan
+    }
+  }
+  T med = amed.value();
+  if (abig.s > 0) {
+    // medium values may still matter, small ones do not
+    if (med > 0 || std::isnan(med)) abig.add_sq((med * sbig) * sbig);
+    return sqrt2(abig.s, abig.c) / sbig;
+  }
+  if (asml.s > 0) {
+    if (med > 0 || std::isnan(med)) {
+      T ymed = sqrt2(amed.s, amed.c);
+      T ysml = sqrt2(asml.s, asml.c) / ssml;
+      T ymin = (ysml > ymed) ? ymed : ysml;
+      T ymax = (ysml > ymed) ? ysml : ymed;
+      T q = ymin / ymax;
+      return ymax * std::sqrt(1 + q * q);
+    }
+    return sqrt2(asml.s, asml.c) / ssml;
+  }
+  return sqrt2(amed.s, amed.c);
+}
+
+}  // namespace detail
+
+// compensated sum of squares of 'n' elements of 'x' (overflows only when
+// the result itself does)
+template <class T>
+T sumsq(const T* x, std::size_t n) {
+  return dot2(x, x, n);
+}
+
+// Euclidean norm of 'n' elements of 'x', compensated and overflow-safe
+template <class T>
+T norm2(const T* x, std::size_t n) {
+  if (n == 0) return T(0);
+  T amin, amax;
+  detail::abs_range(x, n, amin, amax);
+  typedef detail::blue_constants<T> b;
+  // nan inputs go to the fast path (and give nan)
+  if (amax > b::tbig() || amin < b::tsml()) return detail::norm2_blue(x, n);
+  const std::size_t L = bulk_lanes<T>::value;
+  T p[L];
+  T s[L];
+  for (std::size_t k = 0; k < L; k++) {
+    p[k] = 0;
+    s[k] = 0;
+  }
+  detail::dot2_lanes<T, L>(x, x, n, p, s);
+  T fs, fc;
+  detail::fold_partials(p, s, L, fs, fc);
+  if (fs == 0) return T(0);  // all zeros
+  return detail::sqrt2(fs, fc);
+}
+
+// sqrt(x^2 + y^2), compensated and overflow-safe (like 'std::hypot')
+template <class T>
+T comp_hypot(T x, T y) {
+  const T v[2] = {x, y};
+  return norm2(v, 2);
+}
+
+}  // namespace kahan
@@ -0,0 +1,296 @@
+#pragma once
+
+// numa.hpp: NUMA-aware parallel compensated summation (Linux only)
+//
+// Nodes and their cpus are read from /sys/devices/system/node (one node
+// with all cpus when not available). 'numa_for' splits [0, n) in one
+// contiguous range per node (in proportion to its cpus), and each node
+// range in one range per thread; threads are bound to the cpus of their
+// node. Initializing data with 'numa_for' (first touch) places each page on
+// the node that will later read it with the same split, so 'numa_sum' reads
+// local memory only. Pages must not be written before that: use
+// 'numa_buffer' (an anonymous mapping) rather than 'std::vector<T>(n)',
+// which zero-fills all pages on the calling thread, placing them all on
+// its node. Partials are merged per node (thread order), then across nodes
+// (node order), so results only depend on the topology.
+
+#include <dirent.h>    // opendir
+#include <pthread.h>   // pthread_setaffinity_np
+#include <sched.h>     // cpu_set_t
+#include <sys/mman.h>  // mmap
+
+#include <algorithm>    // sort
+#include <cerrno>       // errno
+#include <cstddef>      // size_t
+#include <cstdio>       // fopen, fgets
+#include <cstdlib>      // strtoul
+#include <limits>       // numeric_limits
+#include <string>
+#include <thread>
+#include <type_traits>  // is_trivially_copyable
+#include <utility>      // swap
+#include <vector>
+//
+#include "neumaier.hpp"  // tneumaier (result type)
+#include "parallel.hpp"  // default_threads
+#include "sum.hpp"       // detail::sum_lanes, fold_partials
+
+namespace kahan {
+
+struct numa_node {
+  unsigned id;
+  std::vector<unsigned> cpus;
+};
+
+namespace detail {
+
+// parses a cpu list like "0-3,8,10-11" (appends to 'cpus')
+inline bool parse_cpulist(const char* s, std::vector<unsigned>& cpus) {
+  while (*s != '\0' && *s != '\n') {
+    char* end;
+    const unsigned long a = std::strtoul(s, &end, 10);
+    if (end == s) return false;
+    unsigned long b = a;
+    s = end;
+    if (*s == '-') {
+      b = std::strtoul(s + 1, &end, 10);
+      if (end == s + 1 || b < a) return false;
+      s = end;
+    }
+    for (unsigned long c = a; c <= b; c++) cpus.push_back(unsigned(c));
+    if (*s == ',') s++;
+  }
+  return true;
+}
+
+}  // namespace detail
+
+// nodes with cpus under 'root', sorted by id (one node with all cpus when
+// 'root' can not be read)
+inline std::vector<numa_node> numa_nodes(
+    const char* root = "/sys/devices/system/node") {
+  std::vector<numa_node> nodes;
+  DIR* dir = ::opendir(root);
+  if (dir) {
+    while (struct dirent* e = ::readdir(dir)) {
+      const std::string name = e->d_name;
+      if (name.size() <= 4 || name.compare(0, 4, "node") != 0) continue;
+      char* end;
+      const unsigned long id = std::strtoul(name.c_str() + 4, &end, 10);
+      if (*end != '\0') continue;
+      const std::string path = std::string(root) + "/" + name + "/cpulist";
+      std::FILE* f = std::fopen(path.c_str(), "r");
+      if (!f) continue;
+      char line[4096];
+      numa_node node;
+      node.id = unsigned(id);
+      if (std::fgets(line, sizeof(line), f) &&
+          detail::parse_cpulist(line, node.cpus) && !node.cpus.empty())
+        nodes.push_back(node);  // memory-only nodes are skipped
+      std::fclose(f);
+    }
+    ::closedir(dir);
+  }
+  if (nodes.empty()) {
+    numa_node all;
+    all.id = 0;
+    for (unsigned c = 0; c < default_threads(); c++) all.cpus.push_back(c);
+    nodes.push_back(all);
+  }
+  // readdir order is arbitrary
+  std::sort(nodes.begin(), nodes.end(),
+            [](const numa_node& a, const numa_node& b) { return a.id < b.id; });
+  return nodes;
+}
+
+// binds calling thread to 'cpus'; returns false on failure (see 'errno')
+inline bool bind_to_cpus(const std::vector<unsigned>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::size_t i = 0; i < cpus.size(); i++)
+    if (cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i], &set);
+  const int r = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (r != 0) {
+    errno = r;
+    return false;
+  }
+  return true;
+}
+
+// =========================================================
+
+// 'size()' values of T in an anonymous private mapping (unmapped on
+// destruction). Pages read as zero and are only placed on a node when first
+// written (see above).
+template <class T>
+class numa_buffer {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Expected trivially copyable T");
+
+ private:
+  T* ptr{nullptr};
+  std::size_t n{0};
+
+ public:
+  numa_buffer() {}
+
+  // see 'allocate' (empty on failure)
+  explicit numa_buffer(std::size_t count) { allocate(count); }
+
+  numa_buffer(const numa_buffer&) = delete;
+  numa_buffer& operator=(const numa_buffer&) = delete;
+
+  numa_buffer(numa_buffer&& other) noexcept { swap(other); }
+
+  numa_buffer& operator=(numa_buffer&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~numa_buffer() { release(); }
+
+  // maps 'count' values; returns false on failure (see 'errno')
+  bool allocate(std::size_t count) {
+    release();
+    if (count == 0) return true;
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      errno = ENOMEM;
+      return false;
+    }
+    void* p = ::mmap(nullptr, count * sizeof(T), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return false;
+    ptr = static_cast<T*>(p);
+    n = count;
+    return true;
+  }
+
+  void release() {
+    if (ptr) ::munmap(ptr, n * sizeof(T));
+    ptr = nullptr;
+    n = 0;
+  }
+
+  void swap(numa_buffer& other) noexcept {
+    std::swap(ptr, other.ptr);
+    std::swap(n, other.n);
+  }
+
+  T* data() { return ptr; }
+
+  const T* data() const { return ptr; }
+
+  std::size_t size() const { return n; }
+
+  T& operator[](std::size_t i) { return ptr[i]; }
+
+  const T& operator[](std::size_t i) const { return ptr[i]; }
+};
+
+// =========================================================
+
+// range [begin, end) of a thread of 'node' (index of 'nodes'), 'index' in
+// the split (ranges are in node order, then thread order)
+struct numa_range {
+  std::size_t index;
+  std::size_t node;
+  std::size_t begin;
+  std::size_t end;
+};
+
+namespace detail {
+
+// per node ranges in proportion to cpus, then 'threads_per_node' ranges
+// each (0 means one per cpu)
+inline std::vector<numa_range> numa_split(std::size_t n,
+                                          const std::vector<numa_node>& nodes,
+                                          unsigned threads_per_node) {
+  std::size_t total = 0;
+  for (std::size_t k = 0; k < nodes.size(); k++) total += nodes[k].cpus.size();
+  // start of the range of 'cum' cpus (no overflow of n * cum)
+  auto at = [n, total](std::size_t cum) {
+    return n / total * cum + n % total * cum / total;
+  };
+  std::vector<numa_range> r;
+  std::size_t cum = 0;
+  for (std::size_t k = 0; k < nodes.size(); k++) {
+    const std::size_t b = at(cum);
+    cum += nodes[k].cpus.size();
+    const std::size_t e = at(cum);
+    const std::size_t t =
+        threads_per_node ? threads_per_node : nodes[k].cpus.size();
+    for (std::size_t i = 0; i < t; i++) {
+      numa_range x;
+      x.index = r.size();
+      x.node = k;
+      x.begin = b + (e - b) / t * i + (e - b) % t * i / t;
+      x.end = b + (e - b) / t * (i + 1) + (e - b) % t * (i + 1) / t;
+      r.push_back(x);
+    }
+  }
+  return r;
+}
+
+}  // namespace detail
+
+// calls 'f(range)' for each range of [0, n), each on its own thread bound to
+// its node cpus (binding is best effort: unknown cpus are not an error).
+// 'nodes' must have cpus (as given by 'numa_nodes').
+template <class F>
+void numa_for(std::size_t n, const std::vector<numa_node>& nodes,
+              unsigned threads_per_node, F f) {
+  const std::vector<numa_range> ranges =
+      detail::numa_split(n, nodes, threads_per_node);
+  std::vector<std::thread> workers;
+  workers.reserve(ranges.size());
+  for (std::size_t i = 0; i < ranges.size(); i++) {
+    const numa_range r = ranges[i];
+    const std::vector<unsigned>* cpus = &nodes[r.node].cpus;
+    workers.emplace_back([r, cpus, &f]() {
+      bind_to_cpus(*cpus);
+      f(r);
+    });
+  }
+  for (std::size_t i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+// compensated sum of 'n' elements of 'data' (initialized by 'numa_for' with
+// the same nodes and threads, for local reads). Reads are only local if no
+// page of 'data' was written before that: allocate it with 'numa_buffer'
+// (not 'std::vector<T>(n)', which touches every page on the calling thread).
+template <class T, class X>
+tneumaier<T, neumaier_branchless> numa_sum(const X* data, std::size_t n,
+                                           const std::vector<numa_node>& nodes,
+                                           unsigned threads_per_node = 0) {
+  // small inputs are not worth threads
+  if (n < (1 << 16)) return bulk_sum<T>(data, n);
+  const std::vector<numa_range> ranges =
+      detail::numa_split(n, nodes, threads_per_node);
+  std::vector<T> s(ranges.size());
+  std::vector<T> c(ranges.size());
+  numa_for(n, nodes, threads_per_node, [&](const numa_range& r) {
+    detail::sum_lanes(data + r.begin, r.end - r.begin, s[r.index],
+                      c[r.index]);
+  });
+  // per node, then across nodes
+  std::vector<T> ns(nodes.size());
+  std::vector<T> nc(nodes.size());
+  std::size_t first = 0;
+  for (std::size_t k = 0; k < nodes.size(); k++) {
+    std::size_t last = first;
+    while (last < ranges.size() && ranges[last].node == k) last++;
+    detail::fold_partials(s.data() + first, c.data() + first, last - first,
+                          ns[k], nc[k]);
+    first = last;
+  }
+  T fs, fc;
+  detail::fold_partials(ns.data(), nc.data(), nodes.size(), fs, fc);
+  return tneumaier<T, neumaier_branchless>(fs, fc);
+}
+
+template <class T, class X>
+tneumaier<T, neumaier_branchless> numa_sum(const X* data, std::size_t n) {
+  return numa_sum<T>(data, n, numa_nodes());
+}
+
+}  // namespace kahan
@@ -0,0 +1,88 @@
+#pragma once
+
+// parallel.hpp: multi-threaded bulk compensated summation
+//
+// Data is split in one contiguous chunk per thread; partial results are
+// merged in chunk order, so results do not depend on thread scheduling
+// (but do depend on the number of threads).
+
+#include <cstddef>  // size_t
+#include <thread>
+#include <vector>
+//
+#include "sum.hpp"  // detail::sum_lanes, detail::fold_partials
+
+namespace kahan {
+
+// number of threads used when zero is given
+inline unsigned default_threads() {
+  unsigned n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+namespace detail {
+
+// number of threads for 'n' elements with at least 'min_chunk' each
+inline unsigned range_threads(std::size_t n, unsigned threads,
+                              std::size_t min_chunk) {
+  if (threads == 0) threads = default_threads();
+  if (min_chunk == 0) min_chunk = 1;
+  if (n / min_chunk < threads) threads = unsigned(n / min_chunk);
+  return threads == 0 ? 1 : threads;
+}
+
+// calls 'f(t, begin, end)' on range 't' of 'threads' contiguous ranges of
+// [0, n), one per thread (calling thread takes the last range)
+template <class F>
+void parallel_chunks(std::size_t n, unsigned threads, F f) {
+  if (threads <= 1) {
+    f(0u, std::size_t(0), n);
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  const std::size_t chunk = n / threads;
+  for (unsigned t = 0; t + 1 < threads; t++)
+    workers.emplace_back(f, t, t * chunk, (t + 1) * chunk);
+  f(threads - 1, (threads - 1) * chunk, n);
+  for (std::size_t t = 0; t < workers.size(); t++) workers[t].join();
+}
+
+// calls 'f(begin, end)' on one contiguous range of [0, n) per thread, with
+// at least 'min_chunk' elements each (calling thread takes the last range)
+template <class F>
+void parallel_ranges(std::size_t n, unsigned threads, std::size_t min_chunk,
+                     F f) {
+  parallel_chunks(n, range_threads(n, threads, min_chunk),
+                  [f](unsigned, std::size_t begin, std::size_t end) {
+                    f(begin, end);
+                  });
+}
+
+}  // namespace detail
+
+// compensated sum of 'n' elements of 'data' using 'threads' threads
+// (0 means 'default_threads()'); each thread sums its own chunk, so the
+// result depends on the number of threads, as for 'numa_sum' (use
+// 'pool_sum', with partials of fixed blocks, for the same result anywhere)
+template <class T, class X>
+tneumaier<T, neumaier_branchless> parallel_sum(const X* data, std::size_t n,
+                                               unsigned threads = 0) {
+  // small inputs are not worth a thread
+  threads = detail::range_threads(n, threads, 1 << 16);
+  if (threads <= 1) return bulk_sum<T>(data, n);
+
+  std::vector<T> s(threads);
+  std::vector<T> c(threads);
+  detail::parallel_chunks(
+      n, threads,
+      [data, &s, &c](unsigned t, std::size_t begin, std::size_t end) {
+        detail::sum_lanes(data + begin, end - begin, s[t], c[t]);
+      });
+
+  T fs, fc;
+  detail::fold_partials(s.data(), c.data(), s.size(), fs, fc);
+  return tneumaier<T, neumaier_branchless>(fs, fc);
+}
+
+}  // namespace kahan
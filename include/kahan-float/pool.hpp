@@ -0,0 +1,266 @@
+#pragma once
+
+// pool.hpp: work-stealing thread pool for irregular compensated reductions
+//
+// 'work_pool::run(n, f)' calls 'f(id)' once for each task id in [0, n).
+// Ids are split in one contiguous range per thread; a thread takes ids from
+// the front of its own range and, when it runs out, steals the back half of
+// the largest other range, so skewed tasks (heavy groups, long rows) do not
+// leave threads idle.
+//
+// Reductions keep one partial per task id and merge partials in id order:
+// tasks only depend on the input (not on the number of threads), so results
+// are the same whichever thread ran each task.
+//
+// The pool is a separate entry point: 'parallel_sum', 'gemv' and 'gemm'
+// keep static chunking (uniform work, nothing to steal, and no pool for
+// the caller to keep alive); 'pool_sum' is the pool version of
+// 'parallel_sum'.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>  // size_t
+#include <functional>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+//
+#include "aligned.hpp"   // aligned_vector, padded
+#include "merge.hpp"     // merge
+#include "neumaier.hpp"  // tneumaier (result type)
+#include "parallel.hpp"  // default_threads
+#include "sum.hpp"       // detail::sum_lanes, fold_partials
+
+namespace kahan {
+
+class work_pool {
+ private:
+  // ids [begin, end) left for one thread
+  struct range {
+    std::mutex m;
+    std::size_t begin{0};
+    std::size_t end{0};
+  };
+
+  std::vector<std::unique_ptr<range>> ranges;  // workers, then caller
+  std::vector<std::thread> workers;
+  std::mutex m;
+  std::condition_variable cv;
+  std::function<void(std::size_t)> job;
+  std::size_t generation{0};
+  unsigned idle{0};  // workers done with current generation
+  bool stop{false};
+  std::atomic<std::size_t> steals{0};
+
+ public:
+  // 'threads' threads in total, caller included (0 means 'default_threads()')
+  explicit work_pool(unsigned threads = 0) {
+    if (threads == 0) threads = default_threads();
+    for (unsigned t = 0; t < threads; t++)
+      this->ranges.push_back(std::unique_ptr<range>(new range()));
+    this->idle = threads - 1;
+    for (unsigned t = 0; t + 1 < threads; t++)
+      this->workers.emplace_back([this, t]() { this->loop(t); });
+  }
+
+  work_pool(const work_pool&) = delete;
+  work_pool& operator=(const work_pool&) = delete;
+
+  ~work_pool() {
+    {
+      std::lock_guard<std::mutex> lock(this->m);
+      this->stop = true;
+    }
+    this->cv.notify_all();
+    for (std::size_t t = 0; t < this->workers.size(); t++)
+      this->workers[t].join();
+  }
+
+  unsigned size() const { return unsigned(this->ranges.size()); }
+
+  // number of steals so far (for tuning)
+  std::size_t getSteals() const { return this->steals.load(); }
+
+  // calls 'f(id)' for each id in [0, n), returns when all are done (not
+  // reentrant: 'f' must not call 'run' on the same pool)
+  template <class F>
+  void run(std::size_t n, F f) {
+    const std::size_t p = this->ranges.size();
+    std::unique_lock<std::mutex> lock(this->m);
+    this->job = f;
+    for (std::size_t t = 0; t < p; t++) {
+      std::lock_guard<std::mutex> rl(this->ranges[t]->m);
+      this->ranges[t]->begin = n * t / p;
+      this->ranges[t]->end = n * (t + 1) / p;
+    }
+    this->idle = 0;
+    this->generation++;
+    lock.unlock();
+    this->cv.notify_all();
+
+    this->work(unsigned(p - 1));  // caller takes the last range
+
+    // workers must leave 'job' before it changes
+    lock.lock();
+    this->cv.wait(lock,
+                  [this]() { return this->idle == this->workers.size(); });
+    this->job = nullptr;
+  }
+
+ private:
+  void loop(unsigned self) {
+    std::size_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(this->m);
+        this->cv.wait(lock, [this, seen]() {
+          return this->stop || this->generation != seen;
+        });
+        if (this->stop) return;
+        seen = this->generation;
+      }
+      this->work(self);
+      {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->idle++;
+      }
+      this->cv.notify_all();
+    }
+  }
+
+  // runs tasks until no range has ids left
+  void work(unsigned self) {
+    std::size_t id;
+    while (this->pop(self, id) || this->steal(self, id)) this->job(id);
+  }
+
+  bool pop(unsigned self, std::size_t& id) {
+    range& r = *this->ranges[self];
+    std::lock_guard<std::mutex> lock(r.m);
+    if (r.begin == r.end) return false;
+    id = r.begin++;
+    return true;
+  }
+
+  // takes the back half of the largest other range: one id to run now, the
+  // rest into own (empty) range
+  bool steal(unsigned self, std::size_t& id) {
+    for (;;) {
+      std::size_t victim = self;
+      std::size_t most = 0;
+      for (std::size_t t = 0; t < this->ranges.size(); t++) {
+        if (t == self) continue;
+        std::lock_guard<std::mutex> lock(this->ranges[t]->m);
+        const std::size_t left = this->ranges[t]->end - this->ranges[t]->begin;
+        if (left > most) {
+          most = left;
+          victim = t;
+        }
+      }
+      if (most == 0) return false;
+      std::size_t b, e;
+      {
+        range& v = *this->ranges[victim];
+        std::lock_guard<std::mutex> lock(v.m);
+        if (v.begin == v.end) continue;  // taken meanwhile, look again
+        b = v.begin + (v.end - v.begin) / 2;
+        e = v.end;
+        v.end = b;
+      }
+      this->steals++;
+      id = b;
+      range& own = *this->ranges[self];
+      std::lock_guard<std::mutex> lock(own.m);
+      own.begin = b + 1;
+      own.end = e;
+      return true;
+    }
+  }
+};
+
+// =========================================================
+
+// merges partials 'part' in index order into 'acc' (elements of 'part'
+// may be 'Acc' or derived from it, as 'padded<Acc>')
+template <class Acc, class Parts>
+Acc& merge_ordered(Acc& acc, const Parts& part) {
+  for (std::size_t i = 0; i < part.size(); i++)
+    merge(acc, static_cast<const Acc&>(part[i]));
+  return acc;
+}
+
+// runs 'f(id, partial)' for each task id in [0, n) on 'pool', each task
+// with its own partial, merged in id order
+template <class Acc, class F>
+Acc pool_reduce(work_pool& pool, std::size_t n, F f) {
+  // padded: partials of tasks on different threads share no cache line
+  aligned_vector<padded<Acc>> part(n);
+  pool.run(n, [&part, &f](std::size_t id) {
+    f(id, static_cast<Acc&>(part[id]));
+  });
+  Acc acc;
+  merge_ordered(acc, part);
+  return acc;
+}
+
+// compensated sum of 'n' elements of 'data' in tasks of 'grain' elements
+// (same result for any pool size)
+template <class T, class X>
+tneumaier<T, neumaier_branchless> pool_sum(work_pool& pool, const X* data,
+                                           std::size_t n,
+                                           std::size_t grain = 1 << 16) {
+  if (grain == 0) grain = 1;
+  const std::size_t tasks = (n + grain - 1) / grain;
+  std::vector<T> s(tasks);
+  std::vector<T> c(tasks);
+  pool.run(tasks, [&](std::size_t id) {
+    const std::size_t b = id * grain;
+    const std::size_t k = (n - b < grain) ? n - b : grain;
+    detail::sum_lanes(data + b, k, s[id], c[id]);
+  });
+  T fs, fc;
+  detail::fold_partials(s.data(), c.data(), tasks, fs, fc);
+  return tneumaier<T, neumaier_branchless>(fs, fc);
+}
+
+// compensated sums of 'm' rows of different lengths: row 'i' has 'len[i]'
+// elements at 'rows[i]'. Long rows are split in tasks of 'grain' elements.
+// Row sums go to 'row_sums' (if not null), the total is returned.
+template <class T, class X>
+tneumaier<T, neumaier_branchless> ragged_sum(work_pool& pool,
+                                             const X* const* rows,
+                                             const std::size_t* len,
+                                             std::size_t m, T* row_sums,
+                                             std::size_t grain = 1 << 14) {
+  if (grain == 0) grain = 1;
+  // tasks of row i: [first[i], first[i + 1])
+  std::vector<std::size_t> first(m + 1, 0);
+  for (std::size_t i = 0; i < m; i++)
+    first[i + 1] = first[i] + (len[i] + grain - 1) / grain;
+  const std::size_t tasks = first[m];
+  std::vector<std::size_t> row(tasks);
+  for (std::size_t i = 0; i < m; i++)
+    for (std::size_t t = first[i]; t < first[i + 1]; t++) row[t] = i;
+  std::vector<T> s(tasks);
+  std::vector<T> c(tasks);
+  pool.run(tasks, [&](std::size_t id) {
+    const std::size_t i = row[id];
+    const std::size_t b = (id - first[i]) * grain;
+    const std::size_t k = (len[i] - b < grain) ? len[i] - b : grain;
+    detail::sum_lanes(rows[i] + b, k, s[id], c[id]);
+  });
+  if (row_sums) {
+    for (std::size_t i = 0; i < m; i++) {
+      T rs, rc;
+      detail::fold_partials(s.data() + first[i], c.data() + first[i],
+                            first[i + 1] - first[i], rs, rc);
+      row_sums[i] = rs + rc;
+    }
+  }
+  T fs, fc;
+  detail::fold_partials(s.data(), c.data(), tasks, fs, fc);
+  return tneumaier<T, neumaier_branchless>(fs, fc);
+}
+
+}  // namespace kahan
@@ -0,0 +1,238 @@
+#pragma once
+
+// ranges.hpp: C++20 ranges algorithms and views for compensated sums
+//
+// 'ranges::sum<Acc>(r)' and 'ranges::fold(r, acc)' take any input range
+// (lazy views included). Arithmetic elements are copied in blocks into a
+// buffer on the stack and added to the lanes of sum.hpp (vectorized), so
+// no vector of the whole range is needed; contiguous ranges go straight to
+// the bulk kernel. 'views::kahan_partial_sum' yields running compensated
+// sums, lazily.
+//
+// Needs C++20 <ranges> ('KAHAN_HAS_RANGES' is then 1).
+
+#include <cstddef>  // size_t
+//
+#include "merge.hpp"     // merge
+#include "neumaier.hpp"  // nfloat64 (default accumulator)
+#include "sum.hpp"       // bulk_add, detail::add_lanes, fold_partials
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+#endif
+
+#if defined(__cpp_lib_ranges)
+#define KAHAN_HAS_RANGES 1
+#include <functional>  // identity, invoke
+#include <iterator>
+#include <type_traits>
+#include <utility>  // move, forward
+#else
+#define KAHAN_HAS_RANGES 0
+#endif
+
+#if KAHAN_HAS_RANGES
+
+namespace kahan {
+
+namespace detail {
+
+// adds 'proj(x)' of all elements of 'r' to 'acc'
+template <class Acc, class R, class Proj>
+void add_range(Acc& acc, R&& r, Proj& proj) {
+  using T = decltype(acc.getValue());
+  using X = std::remove_cvref_t<
+      std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>>;
+  if constexpr (!std::is_arithmetic_v<X>) {
+    // accumulators (partials) or other element types
+    for (auto&& x : r) {
+      if constexpr (requires(Acc& a, const X& p) { merge(a, p); })
+        merge(acc, std::invoke(proj, x));
+      else
+        acc += std::invoke(proj, x);
+    }
+  } else if constexpr (std::ranges::contiguous_range<R> &&
+                       std::ranges::sized_range<R> &&
+                       std::is_same_v<Proj, std::identity>) {
+    bulk_add(acc, std::ranges::data(r), std::size_t(std::ranges::size(r)));
+  } else {
+    const std::size_t L = bulk_lanes<T>::value;
+    const std::size_t B = 256;  // multiple of L: same lanes as one call
+    static_assert(B % bulk_lanes<T>::value == 0, "Expected whole lanes");
+    T s[L] = {};
+    T c[L] = {};
+    T buf[B];
+    std::size_t b = 0;
+    for (auto&& x : r) {
+      buf[b++] = static_cast<T>(std::invoke(proj, x));
+      if (b == B) {
+        add_lanes(buf, B, s, c);
+        b = 0;
+      }
+    }
+    add_lanes(buf, b, s, c);
+    T fs, fc;
+    fold_partials(s, c, L, fs, fc);
+    acc += fs;
+    acc += fc;
+  }
+}
+
+}  // namespace detail
+
+namespace ranges {
+
+// compensated sum of 'proj(x)' over 'r'
+template <class Acc = nfloat64, std::ranges::input_range R,
+          class Proj = std::identity>
+Acc sum(R&& r, Proj proj = {}) {
+  Acc acc;
+  detail::add_range(acc, std::forward<R>(r), proj);
+  return acc;
+}
+
+// adds 'proj(x)' of all elements of 'r' to 'init' (any accumulator;
+// elements of the same accumulator type are merged)
+template <std::ranges::input_range R, class Acc, class Proj = std::identity>
+Acc fold(R&& r, Acc init, Proj proj = {}) {
+  detail::add_range(init, std::forward<R>(r), proj);
+  return init;
+}
+
+}  // namespace ranges
+
+// =========================================================
+
+// running compensated sums of 'V' (values of 'Acc')
+template <std::ranges::input_range V, class Acc>
+  requires std::ranges::view<V>
+class kahan_partial_sum_view
+    : public std::ranges::view_interface<kahan_partial_sum_view<V, Acc>> {
+ private:
+  V base_ = V();
+
+ public:
+  using value_type = decltype(std::declval<Acc>().getValue());
+
+  class sentinel;
+
+  class iterator {
+   private:
+    std::ranges::iterator_t<V> it{};
+    std::ranges::sentinel_t<V> last{};
+    // sum up to current element (included): each element is read once
+    Acc acc{};
+
+    void load() {
+      if (this->it != this->last) this->acc += *this->it;
+    }
+
+   public:
+    using iterator_concept =
+        std::conditional_t<std::ranges::forward_range<V>,
+                           std::forward_iterator_tag, std::input_iterator_tag>;
+    using value_type = kahan_partial_sum_view::value_type;
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    iterator() = default;
+
+    iterator(std::ranges::iterator_t<V> _it, std::ranges::sentinel_t<V> _last)
+        : it(std::move(_it)), last(std::move(_last)) {
+      this->load();
+    }
+
+    const std::ranges::iterator_t<V>& base() const { return this->it; }
+
+    // sum up to current element (included)
+    value_type operator*() const { return this->acc.getValue(); }
+
+    iterator& operator++() {
+      ++this->it;
+      this->load();
+      return *this;
+    }
+
+    void operator++(int) { ++(*this); }
+
+    iterator operator++(int)
+      requires std::ranges::forward_range<V>
+    {
+      iterator old = *this;
+      ++(*this);
+      return old;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b)
+      requires std::equality_comparable<std::ranges::iterator_t<V>>
+    {
+      return a.it == b.it;
+    }
+  };
+
+  class sentinel {
+   private:
+    std::ranges::sentinel_t<V> end{};
+
+   public:
+    sentinel() = default;
+
+    explicit sentinel(std::ranges::sentinel_t<V> _end)
+        : end(std::move(_end)) {}
+
+    friend bool operator==(const iterator& a, const sentinel& b) {
+      return a.base() == b.end;
+    }
+  };
+
+  kahan_partial_sum_view()
+    requires std::default_initializable<V>
+  = default;
+
+  explicit kahan_partial_sum_view(V base) : base_(std::move(base)) {}
+
+  V base() const& { return this->base_; }
+
+  iterator begin() {
+    return iterator(std::ranges::begin(this->base_),
+                    std::ranges::end(this->base_));
+  }
+
+  sentinel end() { return sentinel(std::ranges::end(this->base_)); }
+
+  auto size()
+    requires std::ranges::sized_range<V>
+  {
+    return std::ranges::size(this->base_);
+  }
+};
+
+namespace views {
+
+// range adaptor: 'r | views::kahan_partial_sum'
+template <class Acc>
+struct kahan_partial_sum_fn {
+  template <std::ranges::viewable_range R>
+  auto operator()(R&& r) const {
+    return kahan_partial_sum_view<std::views::all_t<R>, Acc>(
+        std::views::all(std::forward<R>(r)));
+  }
+
+  template <std::ranges::viewable_range R>
+  friend auto operator|(R&& r, const kahan_partial_sum_fn& f) {
+    return f(std::forward<R>(r));
+  }
+};
+
+inline constexpr kahan_partial_sum_fn<nfloat64> kahan_partial_sum{};
+
+// with any accumulator: 'r | views::kahan_partial_sum_as<kfloat32>'
+template <class Acc>
+inline constexpr kahan_partial_sum_fn<Acc> kahan_partial_sum_as{};
+
+}  // namespace views
+
+}  // namespace kahan
+
+#endif  // KAHAN_HAS_RANGES
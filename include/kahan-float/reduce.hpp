@@ -0,0 +1,114 @@
+#pragma once
+
+// reduce.hpp: compensated std::reduce and std::transform_reduce
+//
+// The default 'std::plus' of parallel reductions is correct for partials:
+// 'acc + acc' merges both corrections (see kahan.hpp and neumaier.hpp).
+// But 'x + x' of two plain elements is a plain add, rounded before it
+// reaches an accumulator. 'compensated_plus<Acc>' gives every combination
+// (partial or element on either side) an 'Acc' result, so any split chosen
+// by the execution policy keeps the accuracy of a serial compensated sum
+// (results may still differ in the last bits between runs, as the split
+// may differ).
+//
+// Wrappers need C++17 <execution> ('KAHAN_HAS_EXECUTION' is then 1). With
+// libstdc++, parallel policies run on TBB when found (link -ltbb).
+
+#include "merge.hpp"  // merge
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<execution>)
+#include <execution>
+#include <numeric>  // reduce, transform_reduce
+#include <type_traits>
+#include <utility>  // forward
+#define KAHAN_HAS_EXECUTION 1
+#endif
+#endif
+
+#ifndef KAHAN_HAS_EXECUTION
+#define KAHAN_HAS_EXECUTION 0
+#endif
+
+namespace kahan {
+
+// combine of reductions into 'Acc' (associative up to rounding of Acc)
+template <class Acc>
+struct compensated_plus {
+  // partial + partial: both corrections kept (same as 'lhs + rhs')
+  Acc operator()(Acc lhs, const Acc& rhs) const {
+    merge(lhs, rhs);
+    return lhs;
+  }
+
+  // partial + element
+  template <class X>
+  Acc operator()(Acc lhs, const X& rhs) const {
+    lhs += rhs;
+    return lhs;
+  }
+
+  // element + partial
+  template <class X>
+  Acc operator()(const X& lhs, Acc rhs) const {
+    rhs += lhs;
+    return rhs;
+  }
+
+  // element + element
+  template <class X, class Y>
+  Acc operator()(const X& lhs, const Y& rhs) const {
+    Acc acc;
+    acc += lhs;
+    acc += rhs;
+    return acc;
+  }
+};
+
+#if KAHAN_HAS_EXECUTION
+
+// compensated sum of [first, last) (e.g. 'reduce<nfloat64>(par, b, e)')
+template <class Acc, class Policy, class It,
+          class = typename std::enable_if<std::is_execution_policy<
+              typename std::decay<Policy>::type>::value>::type>
+Acc reduce(Policy&& policy, It first, It last, Acc init = Acc()) {
+  return std::reduce(std::forward<Policy>(policy), first, last, init,
+                     compensated_plus<Acc>());
+}
+
+template <class Acc, class It>
+Acc reduce(It first, It last, Acc init = Acc()) {
+  return std::reduce(first, last, init, compensated_plus<Acc>());
+}
+
+// compensated sum of 'f(x)' over [first, last)
+template <class Acc, class Policy, class It, class F,
+          class = typename std::enable_if<std::is_execution_policy<
+              typename std::decay<Policy>::type>::value>::type>
+Acc transform_reduce(Policy&& policy, It first, It last, Acc init, F f) {
+  return std::transform_reduce(std::forward<Policy>(policy), first, last,
+                               init, compensated_plus<Acc>(), f);
+}
+
+template <class Acc, class It, class F>
+Acc transform_reduce(It first, It last, Acc init, F f) {
+  return std::transform_reduce(first, last, init, compensated_plus<Acc>(),
+                               f);
+}
+
+// compensated sum of rounded products 'x[i] * y[i]' (see gemv.hpp 'dot2' for
+// compensated products). 'Acc' is explicit: 'transform_reduce<nfloat64>'
+template <class Acc, class Policy, class It1, class It2,
+          class = typename std::enable_if<std::is_execution_policy<
+              typename std::decay<Policy>::type>::value>::type>
+Acc transform_reduce(Policy&& policy, It1 first1, It1 last1, It2 first2,
+                     typename std::common_type<Acc>::type init = Acc()) {
+  return std::transform_reduce(
+      std::forward<Policy>(policy), first1, last1, first2, init,
+      compensated_plus<Acc>(),
+      [](const auto& x, const auto& y) { return x * y; });
+}
+
+#endif  // KAHAN_HAS_EXECUTION
+
+}  // namespace kahan
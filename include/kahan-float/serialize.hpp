@@ -0,0 +1,321 @@
+#pragma once
+
+// serialize.hpp: binary checkpoint of accumulator state
+//
+// The full state is saved (including pending corrections), so a restored
+// accumulator continues exactly as the original one would. Records are
+// self-describing and may be concatenated:
+//
+//   offset  size  field
+//   0       2     magic "KF"
+//   2       1     format version (1, or 2, see below)
+//   3       1     kind (see 'record_kind')
+//   4       1     width: sizeof(T), 4 (float) or 8 (double)
+//   5       1     reserved (0)
+//   6       2     count: number of values that follow (little-endian)
+//   8       ...   count values, IEEE 754 binary32/64 (little-endian)
+//
+// kahan, neumaier: [value, correction]
+// shewchuk:        [special, inf, partials...] (increasing magnitude)
+// shewchuk (v2):   [special, inf, overflow, partials...]
+//
+// Version 2 is only written for expansions with intermediate overflow, so
+// all other records stay readable by version 1 readers.
+//
+// Fields are at fixed offsets, so records can be read in place (e.g. from
+// a mapped file or a shared memory segment) with no copy or allocation.
+// Byte order does not depend on the host. Only float and double
+// accumulators are supported (not long double, e.g. kfloat128).
+
+#include <cmath>    // isfinite, fabs, floor
+#include <cstddef>  // size_t
+#include <cstdint>  // uint16_t, uint32_t, uint64_t
+#include <cstring>  // memcpy
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+//
+#include "fsum.hpp"      // tshewchuk
+#include "kahan.hpp"     // tkahan
+#include "neumaier.hpp"  // tneumaier
+
+namespace kahan {
+
+enum record_kind : unsigned char {
+  record_kahan = 1,
+  record_neumaier = 2,  // any step policy
+  record_shewchuk = 3
+};
+
+// decoded record header
+struct record_header {
+  unsigned char version;
+  unsigned char kind;
+  unsigned char width;
+  std::uint16_t count;
+};
+
+constexpr unsigned char record_version = 2;  // latest
+constexpr std::size_t record_header_size = 8;
+
+// decodes header of record at 'buf' (with 'n' bytes available)
+// returns false if it is not a record of a known version
+inline bool read_header(const unsigned char* buf, std::size_t n,
+                        record_header& h) {
+  if (n < record_header_size) return false;
+  if (buf[0] != 'K' || buf[1] != 'F' || buf[2] == 0 ||
+      buf[2] > record_version)
+    return false;
+  h.version = buf[2];
+  h.kind = buf[3];
+  h.width = buf[4];
+  h.count = static_cast<std::uint16_t>(buf[6] | (buf[7] << 8));
+  return true;
+}
+
+namespace detail {
+
+template <class T>
+struct record_word {
+  static_assert(sizeof(T) == 0,
+                "Only float and double accumulators can be serialized");
+};
+
+template <>
+struct record_word<float> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct record_word<double> {
+  using type = std::uint64_t;
+};
+
+template <class T>
+void store_le(T v, unsigned char* p) {
+  static_assert(std::numeric_limits<T>::is_iec559,
+                "Expected IEEE 754 float or double");
+  typename record_word<T>::type w;
+  std::memcpy(&w, &v, sizeof(T));
+  for (std::size_t i = 0; i < sizeof(T); i++)
+    p[i] = static_cast<unsigned char>(w >> (8 * i));
+}
+
+template <class T>
+T load_le(const unsigned char* p) {
+  typename record_word<T>::type w = 0;
+  for (std::size_t i = 0; i < sizeof(T); i++)
+    w |= static_cast<typename record_word<T>::type>(p[i]) << (8 * i);
+  T v;
+  std::memcpy(&v, &w, sizeof(T));
+  return v;
+}
+
+// reads values of a record in place
+template <class T>
+struct record_iterator {
+  const unsigned char* p;
+
+  T operator*() const { return load_le<T>(p); }
+
+  record_iterator& operator++() {
+    p += sizeof(T);
+    return *this;
+  }
+
+  bool operator!=(const record_iterator& other) const {
+    return p != other.p;
+  }
+};
+
+template <class T>
+void write_header(unsigned char* buf, record_kind kind, std::size_t count,
+                  unsigned char version = 1) {
+  buf[0] = 'K';
+  buf[1] = 'F';
+  buf[2] = version;
+  buf[3] = kind;
+  buf[4] = sizeof(T);
+  buf[5] = 0;
+  buf[6] = static_cast<unsigned char>(count);
+  buf[7] = static_cast<unsigned char>(count >> 8);
+}
+
+// checks header and size of a record of T values; returns its size or 0
+template <class T>
+std::size_t check_record(const unsigned char* buf, std::size_t n,
+                         record_kind kind, record_header& h) {
+  if (!read_header(buf, n, h)) return 0;
+  if (h.kind != kind || h.width != sizeof(T)) return 0;
+  const std::size_t sz = record_header_size + h.count * sizeof(T);
+  return n < sz ? 0 : sz;
+}
+
+// (val, c) records
+template <class T>
+std::size_t write_pair(record_kind kind, T val, T c, unsigned char* buf,
+                       std::size_t n) {
+  const std::size_t sz = record_header_size + 2 * sizeof(T);
+  if (n < sz) return 0;
+  write_header<T>(buf, kind, 2);
+  store_le(val, buf + record_header_size);
+  store_le(c, buf + record_header_size + sizeof(T));
+  return sz;
+}
+
+template <class T>
+std::size_t read_pair(const unsigned char* buf, std::size_t n,
+                      record_kind kind, T& val, T& c) {
+  record_header h{};
+  std::size_t sz = check_record<T>(buf, n, kind, h);
+  if (sz == 0 || h.version != 1 || h.count != 2) return 0;
+  val = load_le<T>(buf + record_header_size);
+  c = load_le<T>(buf + record_header_size + sizeof(T));
+  return sz;
+}
+
+}  // namespace detail
+
+// ======================
+// record sizes (bytes)
+// ----------------------
+
+template <class T>
+std::size_t serialized_size(const tkahan<T>&) {
+  return record_header_size + 2 * sizeof(T);
+}
+
+template <class T, class Step>
+std::size_t serialized_size(const tneumaier<T, Step>&) {
+  return record_header_size + 2 * sizeof(T);
+}
+
+template <class T, std::size_t N>
+std::size_t serialized_size(const tshewchuk<T, N>& acc) {
+  const std::size_t fields = (acc.getOverflow() != 0) ? 3 : 2;
+  return record_header_size + (fields + acc.size()) * sizeof(T);
+}
+
+// ======================
+// serialize: writes record of 'acc' into 'buf' (with 'n' bytes available)
+// returns bytes written, or 0 if 'buf' is too small
+// ----------------------
+
+template <class T>
+std::size_t serialize(const tkahan<T>& acc, unsigned char* buf,
+                      std::size_t n) {
+  return detail::write_pair(record_kahan, acc.getValue(), acc.getC(), buf, n);
+}
+
+template <class T, class Step>
+std::size_t serialize(const tneumaier<T, Step>& acc, unsigned char* buf,
+                      std::size_t n) {
+  return detail::write_pair(record_neumaier, acc.getRawValue(), acc.getC(),
+                            buf, n);
+}
+
+template <class T, std::size_t N>
+std::size_t serialize(const tshewchuk<T, N>& acc, unsigned char* buf,
+                      std::size_t n) {
+  const bool over = acc.getOverflow() != 0;
+  const std::size_t fields = over ? 3 : 2;
+  const std::size_t count = fields + acc.size();
+  const std::size_t sz = serialized_size(acc);
+  if (count > 0xFFFF || n < sz) return 0;
+  detail::write_header<T>(buf, record_shewchuk, count, over ? 2 : 1);
+  unsigned char* p = buf + record_header_size;
+  detail::store_le(acc.getSpecial(), p);
+  detail::store_le(acc.getInf(), p + sizeof(T));
+  if (over) detail::store_le(acc.getOverflow(), p + 2 * sizeof(T));
+  p += fields * sizeof(T);
+  for (std::size_t i = 0; i < acc.size(); i++, p += sizeof(T))
+    detail::store_le(acc.partial(i), p);
+  return sz;
+}
+
+// ======================
+// deserialize: restores 'acc' from record at 'buf' ('n' bytes available)
+// returns bytes read, or 0 if record is invalid, truncated, or of another
+// kind or width ('acc' is not changed then)
+// ----------------------
+
+template <class T>
+std::size_t deserialize(const unsigned char* buf, std::size_t n,
+                        tkahan<T>& acc) {
+  T val, c;
+  std::size_t sz = detail::read_pair(buf, n, record_kahan, val, c);
+  if (sz) acc = tkahan<T>(val, c);
+  return sz;
+}
+
+template <class T, class Step>
+std::size_t deserialize(const unsigned char* buf, std::size_t n,
+                        tneumaier<T, Step>& acc) {
+  T val, c;
+  std::size_t sz = detail::read_pair(buf, n, record_neumaier, val, c);
+  if (sz) acc = tneumaier<T, Step>(val, c);
+  return sz;
+}
+
+template <class T, std::size_t N>
+std::size_t deserialize(const unsigned char* buf, std::size_t n,
+                        tshewchuk<T, N>& acc) {
+  record_header h{};
+  std::size_t sz = detail::check_record<T>(buf, n, record_shewchuk, h);
+  const std::size_t fields = (h.version == 2) ? 3 : 2;
+  if (sz == 0 || h.count < fields) return 0;
+  const unsigned char* p = buf + record_header_size;
+  // overflow is an integer
+  const T over = (fields == 3) ? detail::load_le<T>(p + 2 * sizeof(T)) : T(0);
+  if (!std::isfinite(over) || over != std::floor(over)) return 0;
+  detail::record_iterator<T> first{p + fields * sizeof(T)};
+  detail::record_iterator<T> last{buf + sz};
+  // partials must be finite, non-zero, and of increasing magnitude (the top
+  // one is zero when a sum cancels exactly)
+  T prev = 0;
+  for (detail::record_iterator<T> it = first; it != last; ++it) {
+    T x = *it;
+    detail::record_iterator<T> next = it;
+    if (x == 0 && !(++next != last)) break;
+    if (!std::isfinite(x) || x == 0 || ::fabs(x) <= prev) return 0;
+    prev = ::fabs(x);
+  }
+  acc.assign(first, last, detail::load_le<T>(p),
+             detail::load_le<T>(p + sizeof(T)), over);
+  return sz;
+}
+
+// ======================
+// stream helpers (checkpoint files)
+// ----------------------
+
+// appends record of 'acc' to 'os'; returns false on write error
+template <class Acc>
+bool write_record(std::ostream& os, const Acc& acc) {
+  std::vector<unsigned char> buf(serialized_size(acc));
+  serialize(acc, buf.data(), buf.size());
+  os.write(reinterpret_cast<const char*>(buf.data()),
+           static_cast<std::streamsize>(buf.size()));
+  return bool(os);
+}
+
+// reads next record from 'is' into 'acc'; returns false on read error or
+// invalid record
+template <class Acc>
+bool read_record(std::istream& is, Acc& acc) {
+  std::vector<unsigned char> buf(record_header_size);
+  if (!is.read(reinterpret_cast<char*>(buf.data()), record_header_size))
+    return false;
+  record_header h{};
+  if (!read_header(buf.data(), buf.size(), h) ||
+      (h.width != 4 && h.width != 8))
+    return false;
+  buf.resize(record_header_size + std::size_t(h.count) * h.width);
+  if (!is.read(reinterpret_cast<char*>(buf.data()) + record_header_size,
+               static_cast<std::streamsize>(buf.size() - record_header_size)))
+    return false;
+  return deserialize(buf.data(), buf.size(), acc) != 0;
+}
+
+}  // namespace kahan
@@ -0,0 +1,109 @@
+#pragma once
+
+// sum.hpp: bulk compensated summation over arrays
+//
+// Values are spread over independent lanes, each one a branchless Neumaier
+// (TwoSum) accumulator, so the loop has no dependency between consecutive
+// elements and can be vectorized. Lanes are folded at the end.
+
+#include <cmath>    // isnan
+#include <cstddef>  // size_t
+//
+#include "eft.hpp"       // two_sum
+#include "neumaier.hpp"  // tneumaier (result type)
+
+namespace kahan {
+
+// number of independent lanes used by bulk kernels (per element type)
+template <class T>
+struct bulk_lanes {
+  static constexpr std::size_t value = 32 / sizeof(T) * 2;  // 2x AVX
+};
+
+namespace detail {
+
+// folds partials (s[i], c[i]) in index order, compensated too
+template <class T>
+void fold_partials(const T* s, const T* c, std::size_t n, T& s_out,
+                   T& c_out) {
+  T fs = 0;
+  T fc = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    T t = fs + s[i];
+    fc += eft::two_sum_error(fs, s[i], t) + c[i];
+    fs = t;
+  }
+  // 'c' is only 'nan' after inf/nan inputs, where 's' is not finite
+  s_out = fs;
+  c_out = std::isnan(fc) ? T(0) : fc;
+}
+
+// adds 'n' elements of 'data' to lanes: s_io[k] are running sums, c_io[k]
+// their (unfolded) errors, element i goes to lane i % L (n should be a multiple
+// of L, except on the last call). 'X' elements are converted to 'T' in
+// registers.
+template <class T, class X>
+void add_lanes(const X* data, std::size_t n, T* s_io, T* c_io) {
+  const std::size_t L = bulk_lanes<T>::value;
+  T s[L];  // locals: no aliasing with 'data'
+  T c[L];
+  for (std::size_t k = 0; k < L; k++) {
+    s[k] = s_io[k];
+    c[k] = c_io[k];
+  }
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    for (std::size_t k = 0; k < L; k++) {
+      T x = static_cast<T>(data[i + k]);
+      T t = s[k] + x;
+      c[k] += eft::two_sum_error(s[k], x, t);
+      s[k] = t;
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    T x = static_cast<T>(data[i]);
+    T t = s[k] + x;
+    c[k] += eft::two_sum_error(s[k], x, t);
+    s[k] = t;
+  }
+  for (std::size_t k = 0; k < L; k++) {
+    s_io[k] = s[k];
+    c_io[k] = c[k];
+  }
+}
+
+// sum of 'n' elements of 'data' over lanes, folded
+template <class T, class X>
+void sum_lanes(const X* data, std::size_t n, T& s_out, T& c_out) {
+  const std::size_t L = bulk_lanes<T>::value;
+  T s[L];
+  T c[L];
+  for (std::size_t k = 0; k < L; k++) {
+    s[k] = 0;
+    c[k] = 0;
+  }
+  add_lanes(data, n, s, c);
+  fold_partials(s, c, L, s_out, c_out);
+}
+
+}  // namespace detail
+
+// compensated sum of 'n' elements of 'data' (value and pending correction)
+template <class T, class X>
+tneumaier<T, neumaier_branchless> bulk_sum(const X* data, std::size_t n) {
+  T s, c;
+  detail::sum_lanes(data, n, s, c);
+  return tneumaier<T, neumaier_branchless>(s, c);
+}
+
+// adds 'n' elements of 'data' to any accumulator (using bulk kernel)
+template <class Acc, class X>
+Acc& bulk_add(Acc& acc, const X* data, std::size_t n) {
+  decltype(acc.getValue()) s, c;
+  detail::sum_lanes(data, n, s, c);
+  acc += s;
+  acc += c;
+  return acc;
+}
+
+}  // namespace kahan
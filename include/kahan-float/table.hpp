@@ -0,0 +1,156 @@
+#pragma once
+
+// table.hpp: allocator-aware tables of accumulators (group-by sums)
+//
+// 'accumulator_table<Key, Acc>' keeps one accumulator per key. Nodes come
+// from 'Alloc' (rebound), so per-request tables can be carved from an
+// arena and released at once. With C++17 <memory_resource>,
+// 'kahan::pmr::accumulator_table' and 'kahan::pmr::vector' use
+// 'std::pmr::polymorphic_allocator' ('KAHAN_HAS_PMR' is then 1):
+//
+//   std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+//   kahan::pmr::accumulator_table<int, kahan::nfloat64> t(&arena);
+
+#include <algorithm>   // sort
+#include <cstddef>     // size_t
+#include <functional>  // hash, equal_to
+#include <memory>      // allocator, allocator_traits
+#include <unordered_map>
+#include <utility>  // pair, declval, move
+#include <vector>
+//
+#include "merge.hpp"  // merge
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define KAHAN_HAS_PMR 1
+#endif
+#endif
+
+#ifndef KAHAN_HAS_PMR
+#define KAHAN_HAS_PMR 0
+#endif
+
+namespace kahan {
+
+template <class Key, class Acc, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, Acc>>>
+class accumulator_table {
+ public:
+  using allocator_type = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<std::pair<const Key, Acc>>;
+  using map_type =
+      std::unordered_map<Key, Acc, Hash, KeyEqual, allocator_type>;
+  using value_type = decltype(std::declval<Acc>().getValue());
+  using const_iterator = typename map_type::const_iterator;
+
+ private:
+  map_type map;
+
+ public:
+  accumulator_table() : map() {}
+
+  explicit accumulator_table(const allocator_type& alloc)
+      : map(0, Hash(), KeyEqual(), alloc) {}
+
+  // with 'buckets' reserved
+  accumulator_table(std::size_t buckets, const allocator_type& alloc)
+      : map(buckets, Hash(), KeyEqual(), alloc) {}
+
+  // allocator-extended copy and move (for containers of tables)
+  accumulator_table(const accumulator_table& other,
+                    const allocator_type& alloc)
+      : map(other.map, alloc) {}
+
+  accumulator_table(accumulator_table&& other, const allocator_type& alloc)
+      : map(std::move(other.map), alloc) {}
+
+  accumulator_table(const accumulator_table&) = default;
+  accumulator_table(accumulator_table&&) = default;
+  accumulator_table& operator=(const accumulator_table&) = default;
+  accumulator_table& operator=(accumulator_table&&) = default;
+
+  allocator_type get_allocator() const { return this->map.get_allocator(); }
+
+  // accumulator of 'key' (created empty)
+  Acc& operator[](const Key& key) { return this->map[key]; }
+
+  // adds 'v' to accumulator of 'key'
+  template <class X>
+  Acc& add(const Key& key, const X& v) {
+    Acc& acc = this->map[key];
+    acc += v;
+    return acc;
+  }
+
+  // adds 'v[i]' to accumulator of 'keys[i]', for 'n' elements
+  template <class X>
+  void add(const Key* keys, const X* v, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) this->map[keys[i]] += v[i];
+  }
+
+  // accumulator of 'key' (null if absent)
+  const Acc* find(const Key& key) const {
+    const_iterator it = this->map.find(key);
+    return (it == this->map.end()) ? nullptr : &it->second;
+  }
+
+  // value of 'key' (zero if absent)
+  value_type getValue(const Key& key) const {
+    const Acc* acc = this->find(key);
+    return acc ? acc->getValue() : value_type(0);
+  }
+
+  // merges accumulators of 'other' (pending corrections kept)
+  template <class H, class E, class A>
+  accumulator_table& merge(
+      const accumulator_table<Key, Acc, H, E, A>& other) {
+    for (const auto& kv : other) kahan::merge(this->map[kv.first], kv.second);
+    return *this;
+  }
+
+  std::size_t size() const { return this->map.size(); }
+
+  bool empty() const { return this->map.empty(); }
+
+  void clear() { this->map.clear(); }
+
+  void reserve(std::size_t n) { this->map.reserve(n); }
+
+  // iteration order is not specified (see 'sorted_keys')
+  const_iterator begin() const { return this->map.begin(); }
+
+  const_iterator end() const { return this->map.end(); }
+
+  // keys in increasing order (for reproducible output)
+  std::vector<Key> sorted_keys() const {
+    std::vector<Key> keys;
+    keys.reserve(this->map.size());
+    for (const auto& kv : this->map) keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }
+};
+
+#if KAHAN_HAS_PMR
+
+namespace pmr {
+
+template <class Key, class Acc, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+using accumulator_table =
+    kahan::accumulator_table<Key, Acc, Hash, KeyEqual,
+                             std::pmr::polymorphic_allocator<
+                                 std::pair<const Key, Acc>>>;
+
+// e.g. 'pmr::vector<kfloat64>'
+template <class Acc>
+using vector = std::pmr::vector<Acc>;
+
+}  // namespace pmr
+
+#endif  // KAHAN_HAS_PMR
+
+}  // namespace kahan
@@ -0,0 +1,165 @@
+#pragma once
+
+// telemetry.hpp: optional counters of numerical events in 'operator+='
+//
+// Disabled by default: KAHAN_TELEMETRY_STEP expands to nothing and this
+// header adds no code. Define KAHAN_TELEMETRY (for the whole program, as
+// it changes the body of 'operator+=' of tkahan and tneumaier) to count,
+// on each thread:
+//
+// - adds:          calls to 'operator+='
+// - cancellations: |val + add| below max(|val|, |add|) by more than half of
+//                  the mantissa bits (catastrophic cancellation)
+// - nan_resets:    'c' was nan and was reset to zero (the 'isnan' branch)
+// - infinities:    infinite inputs
+// - c_overflows:   finite 'val' and 'add' with non-finite sum or 'c'
+//
+// Counters are relaxed atomics written only by their own thread (no lock
+// prefix), and can be read from any thread by 'snapshot_all()'.
+
+#ifdef KAHAN_TELEMETRY
+
+#include <atomic>
+#include <cmath>  // fabs, isinf, isfinite, isnan, ldexp
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace kahan {
+
+namespace telemetry {
+
+// counters of one thread, or of many
+struct counters {
+  std::uint64_t adds{0};
+  std::uint64_t cancellations{0};
+  std::uint64_t nan_resets{0};
+  std::uint64_t infinities{0};
+  std::uint64_t c_overflows{0};
+
+  counters& operator+=(const counters& other) {
+    this->adds += other.adds;
+    this->cancellations += other.cancellations;
+    this->nan_resets += other.nan_resets;
+    this->infinities += other.infinities;
+    this->c_overflows += other.c_overflows;
+    return *this;
+  }
+};
+
+namespace detail {
+
+struct thread_counters;
+
+// live threads, and totals of exited ones
+struct registry {
+  std::mutex mutex;
+  std::vector<thread_counters*> live;
+  counters retired;
+};
+
+inline registry& get_registry() {
+  static registry r;  // never destroyed before thread_local objects
+  return r;
+}
+
+struct thread_counters {
+  std::atomic<std::uint64_t> adds{0};
+  std::atomic<std::uint64_t> cancellations{0};
+  std::atomic<std::uint64_t> nan_resets{0};
+  std::atomic<std::uint64_t> infinities{0};
+  std::atomic<std::uint64_t> c_overflows{0};
+
+  thread_counters() {
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.live.push_back(this);
+  }
+
+  ~thread_counters() {
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired += this->load();
+    for (std::size_t i = 0; i < r.live.size(); i++)
+      if (r.live[i] == this) {
+        r.live[i] = r.live.back();
+        r.live.pop_back();
+        break;
+      }
+  }
+
+  counters load() const {
+    counters c;
+    c.adds = this->adds.load(std::memory_order_relaxed);
+    c.cancellations = this->cancellations.load(std::memory_order_relaxed);
+    c.nan_resets = this->nan_resets.load(std::memory_order_relaxed);
+    c.infinities = this->infinities.load(std::memory_order_relaxed);
+    c.c_overflows = this->c_overflows.load(std::memory_order_relaxed);
+    return c;
+  }
+
+  void store(const counters& c) {
+    this->adds.store(c.adds, std::memory_order_relaxed);
+    this->cancellations.store(c.cancellations, std::memory_order_relaxed);
+    this->nan_resets.store(c.nan_resets, std::memory_order_relaxed);
+    this->infinities.store(c.infinities, std::memory_order_relaxed);
+    this->c_overflows.store(c.c_overflows, std::memory_order_relaxed);
+  }
+};
+
+inline thread_counters& local() {
+  static thread_local thread_counters tc;
+  return tc;
+}
+
+// single writer: plain load and store, no read-modify-write
+inline void bump(std::atomic<std::uint64_t>& v) {
+  v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// 't' is fl(val + add) and 'c' the new correction (before any nan reset)
+template <class T>
+void on_step(T val, T add, T t, T c, bool resets) {
+  thread_counters& tc = local();
+  bump(tc.adds);
+  if (std::isinf(add)) bump(tc.infinities);
+  if (std::isfinite(val) && std::isfinite(add)) {
+    if (!std::isfinite(t) || !std::isfinite(c)) bump(tc.c_overflows);
+    const T big = (std::fabs(val) > std::fabs(add)) ? std::fabs(val)
+                                                     : std::fabs(add);
+    const int bits = std::numeric_limits<T>::digits / 2;
+    if (std::fabs(std::ldexp(t, bits)) < big) bump(tc.cancellations);
+  }
+  if (resets && std::isnan(c)) bump(tc.nan_resets);
+}
+
+}  // namespace detail
+
+// counters of this thread
+inline counters snapshot() { return detail::local().load(); }
+
+// counters of all threads (running and exited)
+inline counters snapshot_all() {
+  detail::registry& r = detail::get_registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  counters c = r.retired;
+  for (std::size_t i = 0; i < r.live.size(); i++) c += r.live[i]->load();
+  return c;
+}
+
+// zeros counters of this thread
+inline void reset() { detail::local().store(counters()); }
+
+}  // namespace telemetry
+
+}  // namespace kahan
+
+#define KAHAN_TELEMETRY_STEP(val, add, t, c, resets) \
+  ::kahan::telemetry::detail::on_step(val, add, t, c, resets)
+
+#else
+
+#define KAHAN_TELEMETRY_STEP(val, add, t, c, resets)
+
+#endif
@@ -0,0 +1,182 @@
+#pragma once
+
+// tracked.hpp: accumulators with a running error bound
+//
+// ttracked<Acc> wraps a tkahan or tneumaier accumulator and also keeps the
+// number of elements, the sum of their absolute values and the largest
+// pending correction seen, so 'error_bound()' gives a rigorous bound of
+// |getValue() - exact sum| at any time (u is the unit roundoff, and
+// gamma(k) = k u / (1 - k u)):
+//
+// - tneumaier: every step is an error-free TwoSum, so only the plain sum of
+//   corrections and the final 'val + c' are rounded:
+//     |error| <= u |getValue()| + (n - 1) u max|c|
+// - tkahan (Knuth, TAOCP vol. 2, 4.2.2; Higham, Accuracy and Stability of
+//   Numerical Algorithms, eq. 4.8):
+//     |error| <= (2u + u gamma(4n)) sum|x|
+//
+// The bound is 'inf' when the sum is not finite. It costs one fabs, one add
+// and one max per element, so the slow exact path (e.g. sfloat64) can be
+// run only for the batches where the bound is larger than the tolerance.
+
+#include <cmath>    // fabs, isfinite
+#include <cstddef>  // size_t
+#include <iostream>
+#include <limits>
+#include <utility>  // declval
+//
+#include "kahan.hpp"     // tkahan
+#include "neumaier.hpp"  // tneumaier
+
+namespace kahan {
+
+namespace detail {
+
+// gamma(n) = n u / (1 - n u) ('inf' when n u >= 1)
+template <class T>
+T gamma(std::size_t n) {
+  const T nu = T(n) * (std::numeric_limits<T>::epsilon() / 2);
+  if (!(nu < 1)) return std::numeric_limits<T>::infinity();
+  return nu / (1 - nu);
+}
+
+// upper bound on the exact sum of 'n' non-negative values, from their
+// computed plain sum 'abs_sum'
+template <class T>
+T true_abs_sum(T abs_sum, std::size_t n) {
+  const T g = gamma<T>(n);
+  return abs_sum / (1 - g);  // 'inf' or negative when g >= 1
+}
+
+template <class T>
+T error_bound(const tkahan<T>& acc, std::size_t n, T abs_sum, T max_c) {
+  (void)acc;
+  (void)max_c;
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  const T g = gamma<T>(4 * n);
+  const T s = true_abs_sum(abs_sum, n);
+  if (!std::isfinite(g) || !(s >= 0))
+    return std::numeric_limits<T>::infinity();
+  return (2 * u + u * g) * s;
+}
+
+template <class T, class Step>
+T error_bound(const tneumaier<T, Step>& acc, std::size_t n, T abs_sum,
+              T max_c) {
+  (void)abs_sum;
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  const T steps = (n > 1) ? T(n - 1) : T(0);
+  return u * std::fabs(acc.getValue()) + steps * u * max_c;
+}
+
+}  // namespace detail
+
+// Acc must be tkahan<T> or tneumaier<T, Step>
+template <class Acc>
+struct ttracked {
+  typedef decltype(std::declval<Acc>().getValue()) value_type;
+
+ private:
+  // wrapped accumulator
+  Acc acc;
+  // number of elements
+  std::size_t n{0};
+  // sum of |x| (plain)
+  value_type abs_sum{0};
+  // largest |c| after any step
+  value_type max_c{0};
+
+ public:
+  // build with T value (not 'explicit', may be automatic!)
+  ttracked(value_type _val) { (*this) += _val; }
+
+  // empty
+  ttracked() {}
+
+  value_type getValue() const { return this->acc.getValue(); }
+
+  value_type getC() const { return this->acc.getC(); }
+
+  explicit operator value_type() const { return this->getValue(); }
+
+  // wrapped accumulator
+  const Acc& get() const { return this->acc; }
+
+  // number of elements added
+  std::size_t getCount() const { return this->n; }
+
+  // computed sum of |x| (a plain sum, see 'detail::true_abs_sum')
+  value_type getAbsSum() const { return this->abs_sum; }
+
+  // largest |c| seen so far
+  value_type getMaxC() const { return this->max_c; }
+
+  // rigorous bound on |getValue() - exact sum| ('inf' if not finite)
+  value_type error_bound() const {
+    const value_type inf = std::numeric_limits<value_type>::infinity();
+    if (!std::isfinite(this->getValue()) || !std::isfinite(this->abs_sum))
+      return inf;
+    return detail::error_bound(this->acc, this->n, this->abs_sum, this->max_c);
+  }
+
+  // error bound relative to |getValue()| ('inf' if value is zero)
+  value_type rel_error_bound() const {
+    const value_type v = std::fabs(this->getValue());
+    const value_type e = this->error_bound();
+    if (e == 0) return value_type(0);
+    return (v > 0) ? e / v : std::numeric_limits<value_type>::infinity();
+  }
+
+  // true if |getValue() - exact sum| <= tol is guaranteed
+  bool within(value_type tol) const { return this->error_bound() <= tol; }
+
+  // copy assignment (for any valid element)
+  template <class X>
+  ttracked<Acc>& operator+=(const X& _add) {
+    value_type add = static_cast<value_type>(_add);
+    this->acc += add;
+    this->n++;
+    this->abs_sum += std::fabs(add);
+    const value_type c = std::fabs(this->acc.getC());
+    this->max_c = (c > this->max_c) ? c : this->max_c;
+    return *this;
+  }
+
+  // copy assignment (for any valid element)
+  template <class X>
+  ttracked<Acc>& operator-=(const X& add) {
+    (*this) += -add;  // reuse '+='
+    return *this;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend ttracked<Acc> operator+(ttracked<Acc> lhs, const X& rhs) {
+    lhs += rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // copy return (for any valid element)
+  template <class X>
+  friend ttracked<Acc> operator-(ttracked<Acc> lhs, const X& rhs) {
+    lhs += -rhs;  // reuse '+='
+    return lhs;
+  }
+
+  // ==================
+
+  friend std::ostream& operator<<(std::ostream& os, const ttracked<Acc>& k) {
+    os << k.getValue();
+    return os;
+  }
+};
+
+// =========================================================
+
+using tkfloat32 = ttracked<kfloat32>;
+using tkfloat64 = ttracked<kfloat64>;
+using tnfloat32 = ttracked<nfloat32>;
+using tnfloat64 = ttracked<nfloat64>;
+using tnbfloat64 = ttracked<nbfloat64>;
+
+}  // namespace kahan
@@ -2,6 +2,20 @@
 #include <benchmark/benchmark.h>
 
 #include "bench/kahan.bench.cpp"
+#include "bench/eft.bench.cpp"
+#include "bench/horner.bench.cpp"
+#include "bench/sum.bench.cpp"
+#include "bench/csv.bench.cpp"
+#include "bench/gemv.bench.cpp"
+#include "bench/gemm.bench.cpp"
+#include "bench/norm.bench.cpp"
+#include "bench/adaptive.bench.cpp"
+#include "bench/half.bench.cpp"
+#include "bench/mixed.bench.cpp"
+#include "bench/fixed.bench.cpp"
+#include "bench/pool.bench.cpp"
+#include "bench/numa.bench.cpp"
+#include "bench/aligned.bench.cpp"
 //#include "bench/vector.bench.cpp"
 
 // initializes MAIN
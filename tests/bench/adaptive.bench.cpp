@@ -0,0 +1,58 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/kahan.hpp> // from 'src'
+#include <kahan-float/fsum.hpp> // from 'src'
+#include <kahan-float/adaptive.hpp> // from 'src'
+
+using namespace kahan;
+
+// 'cond' 0: positive values (well-conditioned), 1: large cancelling pairs
+static std::vector<double> genAdaptiveData(long count, long cond)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(0, 1);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c) {
+      double v = runif(engine);
+      if(cond && c % 2 == 0)
+         v *= 1e16;
+      if(cond && c % 2 == 1)
+         v -= data.back();
+      data.push_back(v);
+   }
+   return data;
+}
+
+// one accumulator object, element by element
+template <class F>
+static void loop_adaptive(benchmark::State &state)
+{
+   std::vector<double> data = genAdaptiveData(state.range(0), state.range(1));
+   for (auto _ : state) 
+   {
+      F f = 0;
+      for(double v: data)
+         f += v;
+      benchmark::DoNotOptimize(double(f));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_adaptive, kfloat64)->Args({1 << 16, 0})->Args({1 << 16, 1});
+BENCHMARK_TEMPLATE(loop_adaptive, afloat64)->Args({1 << 16, 0})->Args({1 << 16, 1});
+BENCHMARK_TEMPLATE(loop_adaptive, sfloat64)->Args({1 << 16, 0})->Args({1 << 16, 1});
+
+static void block_adaptive(benchmark::State &state)
+{
+   std::vector<double> data = genAdaptiveData(state.range(0), state.range(1));
+   for (auto _ : state) 
+   {
+      afloat64 f;
+      f.add(data.data(), data.size());
+      benchmark::DoNotOptimize(f.getValue());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(block_adaptive)->Args({1 << 16, 0})->Args({1 << 16, 1});
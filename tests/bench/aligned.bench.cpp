@@ -0,0 +1,75 @@
+#include <vector>
+#include <random>
+#include <thread>
+
+#include <kahan-float/aligned.hpp> // from 'src'
+#include <kahan-float/neumaier.hpp> // from 'src'
+
+using namespace kahan;
+
+static aligned_vector<double> genAlignedData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   aligned_vector<double> data(count + 1);
+   for (auto& v : data)
+      v = runif(engine);
+   return data;
+}
+
+static void sum_aligned(benchmark::State &state)
+{
+   aligned_vector<double> data = genAlignedData(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum<double>(data.data(), state.range(0)));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(sum_aligned)->Arg(1 << 12)->Arg(1 << 20);
+
+// same kernel, one element off the cache line (loads split lines)
+static void sum_misaligned(benchmark::State &state)
+{
+   aligned_vector<double> data = genAlignedData(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum<double>(data.data() + 1, state.range(0)));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(sum_misaligned)->Arg(1 << 12)->Arg(1 << 20);
+
+// one accumulator per thread, neighbours on the same cache line
+static void per_thread_packed(benchmark::State &state)
+{
+   const unsigned threads = 4;
+   for (auto _ : state) 
+   {
+      std::vector<nfloat64> part(threads);
+      std::vector<std::thread> workers;
+      for(unsigned t=0; t<threads; t++)
+         workers.emplace_back([&part, t]() { for(int i=0; i<1000000; i++) { part[t] += 0.1; benchmark::ClobberMemory(); } });
+      for (auto& w : workers) w.join();
+      benchmark::DoNotOptimize(part);
+   }
+}
+BENCHMARK(per_thread_packed);
+
+// same, each accumulator on its own cache line
+static void per_thread_padded(benchmark::State &state)
+{
+   const unsigned threads = 4;
+   for (auto _ : state) 
+   {
+      aligned_vector<padded<nfloat64>> part(threads);
+      std::vector<std::thread> workers;
+      for(unsigned t=0; t<threads; t++)
+         workers.emplace_back([&part, t]() { for(int i=0; i<1000000; i++) { part[t] += 0.1; benchmark::ClobberMemory(); } });
+      for (auto& w : workers) w.join();
+      benchmark::DoNotOptimize(part);
+   }
+}
+BENCHMARK(per_thread_padded);
@@ -0,0 +1,84 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <kahan-float/csv.hpp> // from 'src'
+
+using namespace kahan;
+
+// 'rows' lines of 4 numeric columns
+static std::string genCsvText(long rows)
+{
+   std::ostringstream ss;
+   ss.precision(17);
+   for(long r=0; r<rows; ++r)
+      ss << r * 0.001 << "," << -r * 1e-7 << "," << 1e6 / (r + 1) << "," << r << "\n";
+   return ss.str();
+}
+
+// strtod + operator+= per field, values kept per column (reference)
+static void csv_strtod_vectors(benchmark::State &state)
+{
+   std::string text = genCsvText(state.range(0));
+   for (auto _ : state) 
+   {
+      std::vector<std::vector<double>> cols(4);
+      std::istringstream in(text);
+      std::string line;
+      while (std::getline(in, line)) {
+         const char* p = line.c_str();
+         for (int j=0; j<4; j++) {
+            char* end;
+            cols[j].push_back(strtod(p, &end));
+            p = end + 1;
+         }
+      }
+      std::vector<nfloat64> sums(4);
+      for (int j=0; j<4; j++)
+         for (double v : cols[j])
+            sums[j] += v;
+      benchmark::DoNotOptimize(sums.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(csv_strtod_vectors)->Arg(1 << 14);
+
+// fused parse + accumulation
+static void csv_fused_sum(benchmark::State &state)
+{
+   std::string text = genCsvText(state.range(0));
+   for (auto _ : state) 
+   {
+      csv_sum<nfloat64> s;
+      s.feed(text.data(), text.size());
+      s.finish();
+      benchmark::DoNotOptimize(s.columns().data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(csv_fused_sum)->Arg(1 << 14);
+
+// 'rows' lines of 4 short decimal columns (ledger: cents, rates, counts)
+static std::string genLedgerText(long rows)
+{
+   std::ostringstream ss;
+   for(long r=0; r<rows; ++r)
+      ss << (r * 7919) % 100000 << "." << (r * 31) % 100 << ",-"
+         << r % 1000 << ".5," << "0.0" << r % 97 << "," << r << "\n";
+   return ss.str();
+}
+
+// fused parse + accumulation, short decimals (fast path on any standard)
+static void csv_fused_sum_ledger(benchmark::State &state)
+{
+   std::string text = genLedgerText(state.range(0));
+   for (auto _ : state) 
+   {
+      csv_sum<nfloat64> s;
+      s.feed(text.data(), text.size());
+      s.finish();
+      benchmark::DoNotOptimize(s.columns().data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(csv_fused_sum_ledger)->Arg(1 << 14);
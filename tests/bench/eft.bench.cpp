@@ -0,0 +1,75 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/eft.hpp> // from 'src'
+
+using namespace kahan;
+
+template <class T>
+std::vector<T> genRandomValues(long seed, long count)
+{
+   std::default_random_engine engine;
+  engine.seed(seed);
+  std::uniform_real_distribution<T> runif(-1000, +1000);
+
+   std::vector<T> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(runif(engine));
+
+   return data;
+}
+
+// scalar loop (one transformation per call)
+template <class T>
+static void eft_two_sum_scalar(benchmark::State &state)
+{
+   std::vector<T> a = genRandomValues<T>(0, state.range(0));
+   std::vector<T> b = genRandomValues<T>(1, state.range(0));
+   std::vector<T> s(a.size()), e(a.size());
+   for (auto _ : state) 
+   {
+      for(unsigned i=0; i<a.size(); i++)
+         eft::two_sum(a[i], b[i], s[i], e[i]);
+      benchmark::DoNotOptimize(s.data());
+      benchmark::DoNotOptimize(e.data());
+      benchmark::ClobberMemory();
+   }
+}
+
+// batch version (vectorizable)
+template <class T>
+static void eft_two_sum_batch(benchmark::State &state)
+{
+   std::vector<T> a = genRandomValues<T>(0, state.range(0));
+   std::vector<T> b = genRandomValues<T>(1, state.range(0));
+   std::vector<T> s(a.size()), e(a.size());
+   for (auto _ : state) 
+   {
+      eft::two_sum(a.data(), b.data(), s.data(), e.data(), a.size());
+      benchmark::DoNotOptimize(s.data());
+      benchmark::DoNotOptimize(e.data());
+      benchmark::ClobberMemory();
+   }
+}
+
+template <class T>
+static void eft_two_prod_batch(benchmark::State &state)
+{
+   std::vector<T> a = genRandomValues<T>(0, state.range(0));
+   std::vector<T> b = genRandomValues<T>(1, state.range(0));
+   std::vector<T> p(a.size()), e(a.size());
+   for (auto _ : state) 
+   {
+      eft::two_prod(a.data(), b.data(), p.data(), e.data(), a.size());
+      benchmark::DoNotOptimize(p.data());
+      benchmark::DoNotOptimize(e.data());
+      benchmark::ClobberMemory();
+   }
+}
+
+BENCHMARK_TEMPLATE(eft_two_sum_scalar, float)->Arg(1024);
+BENCHMARK_TEMPLATE(eft_two_sum_batch, float)->Arg(1024);
+BENCHMARK_TEMPLATE(eft_two_sum_scalar, double)->Arg(1024);
+BENCHMARK_TEMPLATE(eft_two_sum_batch, double)->Arg(1024);
+BENCHMARK_TEMPLATE(eft_two_prod_batch, float)->Arg(1024);
+BENCHMARK_TEMPLATE(eft_two_prod_batch, double)->Arg(1024);
@@ -0,0 +1,48 @@
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include <kahan-float/fixed.hpp> // from 'src'
+
+using namespace kahan;
+
+static std::vector<std::int64_t> genFixedData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_int_distribution<std::int64_t> rint(-100000000, +100000000);
+
+   std::vector<std::int64_t> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(rint(engine));
+   return data;
+}
+
+// element by element (carry on each add)
+static void each_fixed(benchmark::State &state)
+{
+   std::vector<std::int64_t> data = genFixedData(state.range(0));
+   for (auto _ : state)
+   {
+      cfixed128 s;
+      for (std::int64_t v : data)
+         s += v;
+      benchmark::DoNotOptimize(s);
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(each_fixed)->Arg(1 << 16);
+
+// 32-bit halves in lanes
+static void bulk_fixed(benchmark::State &state)
+{
+   std::vector<std::int64_t> data = genFixedData(state.range(0));
+   for (auto _ : state)
+   {
+      cfixed128 s;
+      s.add(data.data(), data.size());
+      benchmark::DoNotOptimize(s);
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(bulk_fixed)->Arg(1 << 16);
@@ -0,0 +1,59 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/gemm.hpp> // from 'src'
+#include <kahan-float/kahan.hpp> // from 'src'
+
+using namespace kahan;
+
+static std::vector<double> genGemmData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(runif(engine));
+   return data;
+}
+
+// row-major C = A B, i-k-j loops, one accumulator object per entry
+template <class F>
+static void loop_gemm(benchmark::State &state)
+{
+   long n = state.range(0);
+   std::vector<double> A = genGemmData(n * n);
+   std::vector<double> B = genGemmData(n * n);
+   std::vector<F> C(n * n);
+   for (auto _ : state) 
+   {
+      for(long i=0; i<n*n; i++)
+         C[i] = 0;
+      for(long i=0; i<n; i++)
+         for(long p=0; p<n; p++)
+            for(long j=0; j<n; j++)
+               C[i * n + j] += A[i * n + p] * B[p * n + j];
+      benchmark::DoNotOptimize(C.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_gemm, double)->Arg(256);
+BENCHMARK_TEMPLATE(loop_gemm, kfloat64)->Arg(256);
+
+template <gemm_mode M>
+static void comp_gemm(benchmark::State &state)
+{
+   long n = state.range(0);
+   std::vector<double> A = genGemmData(n * n);
+   std::vector<double> B = genGemmData(n * n);
+   std::vector<double> C(n * n);
+   for (auto _ : state) 
+   {
+      gemm(layout::row_major, M, n, n, n, A.data(), n, B.data(), n, C.data(), n, 1);
+      benchmark::DoNotOptimize(C.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(comp_gemm, gemm_mode::kahan)->Arg(256);
+BENCHMARK_TEMPLATE(comp_gemm, gemm_mode::double_double)->Arg(256);
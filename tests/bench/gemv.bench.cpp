@@ -0,0 +1,58 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/gemv.hpp> // from 'src'
+
+using namespace kahan;
+
+static std::vector<double> genGemvData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(runif(engine));
+   return data;
+}
+
+// row-major y = A x, one accumulator object per row (reference)
+template <class F>
+static void loop_gemv(benchmark::State &state)
+{
+   long n = state.range(0);
+   std::vector<double> A = genGemvData(n * n);
+   std::vector<double> x = genGemvData(n);
+   std::vector<double> y(n);
+   for (auto _ : state) 
+   {
+      for(long i=0; i<n; i++) {
+         F f = 0;
+         for(long j=0; j<n; j++)
+            f += A[i * n + j] * x[j];
+         y[i] = double(f);
+      }
+      benchmark::DoNotOptimize(y.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_gemv, double)->Arg(512);
+BENCHMARK_TEMPLATE(loop_gemv, kfloat64)->Arg(512);
+
+template <layout L>
+static void comp_gemv(benchmark::State &state)
+{
+   long n = state.range(0);
+   std::vector<double> A = genGemvData(n * n);
+   std::vector<double> x = genGemvData(n);
+   std::vector<double> y(n);
+   for (auto _ : state) 
+   {
+      gemv(L, n, n, A.data(), n, x.data(), y.data(), 1);
+      benchmark::DoNotOptimize(y.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(comp_gemv, layout::row_major)->Arg(512);
+BENCHMARK_TEMPLATE(comp_gemv, layout::col_major)->Arg(512);
@@ -0,0 +1,53 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/kahan.hpp> // from 'src'
+#include <kahan-float/half.hpp> // from 'src'
+
+using namespace kahan;
+
+static void toHalf(float v, float16& h) { h = to_float16(v); }
+static void toHalf(float v, bfloat16& h) { h = to_bfloat16(v); }
+
+template <class H>
+static std::vector<H> genHalfData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<float> runif(-1, +1);
+
+   std::vector<H> data(count);
+   for(long c=0; c<count; ++c)
+      toHalf(runif(engine), data[c]);
+   return data;
+}
+
+// element by element, implicit conversion into kfloat32 (reference)
+template <class H>
+static void loop_sum_half(benchmark::State &state)
+{
+   std::vector<H> data = genHalfData<H>(state.range(0));
+   for (auto _ : state) 
+   {
+      kfloat32 f = 0;
+      for(const H& v: data)
+         f += v;
+      benchmark::DoNotOptimize(float(f));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_sum_half, float16)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(loop_sum_half, bfloat16)->Arg(1 << 16);
+
+template <class H>
+static void bulk_sum_half(benchmark::State &state)
+{
+   std::vector<H> data = genHalfData<H>(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum<float>(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(bulk_sum_half, float16)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bulk_sum_half, bfloat16)->Arg(1 << 16);
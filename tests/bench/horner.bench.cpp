@@ -0,0 +1,66 @@
+#include <vector>
+
+#include <kahan-float/horner.hpp> // from 'src'
+
+using namespace kahan;
+
+// degree 'range(0)' polynomial on 4096 points
+static std::vector<double> genPoly(long degree)
+{
+   std::vector<double> a;
+   for(long k=0; k<=degree; ++k)
+      a.push_back(1.0 / (k + 1));
+   return a;
+}
+
+static std::vector<double> genPoints(long count)
+{
+   std::vector<double> x;
+   for(long c=0; c<count; ++c)
+      x.push_back(0.5 + c * (1.0 / count));
+   return x;
+}
+
+static void horner_plain_points(benchmark::State &state)
+{
+   std::vector<double> a = genPoly(state.range(0));
+   std::vector<double> x = genPoints(4096);
+   std::vector<double> out(x.size());
+   for (auto _ : state) 
+   {
+      for(unsigned j=0; j<x.size(); j++)
+         out[j] = horner(a.data(), a.size(), x[j]);
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(horner_plain_points)->Arg(8)->Arg(32);
+
+static void comp_horner_scalar_points(benchmark::State &state)
+{
+   std::vector<double> a = genPoly(state.range(0));
+   std::vector<double> x = genPoints(4096);
+   std::vector<double> out(x.size());
+   for (auto _ : state) 
+   {
+      for(unsigned j=0; j<x.size(); j++)
+         out[j] = comp_horner(a.data(), a.size(), x[j]);
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(comp_horner_scalar_points)->Arg(8)->Arg(32);
+
+static void comp_horner_batch_points(benchmark::State &state)
+{
+   std::vector<double> a = genPoly(state.range(0));
+   std::vector<double> x = genPoints(4096);
+   std::vector<double> out(x.size());
+   for (auto _ : state) 
+   {
+      comp_horner(a.data(), a.size(), x.data(), out.data(), x.size());
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(comp_horner_batch_points)->Arg(8)->Arg(32);
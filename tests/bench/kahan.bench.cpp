@@ -6,6 +6,7 @@
 
 #include <kahan-float/kahan.hpp> // from 'src'
 #include <kahan-float/neumaier.hpp> // from 'src'
+#include <kahan-float/fsum.hpp> // from 'src'
 
 using namespace kahan;
 
@@ -23,6 +24,21 @@ std::set<int> genRandomSet(long seed, long count)
 }
 
 
+// random signs and magnitudes (10^-8 to 10^8): unpredictable for branches
+std::vector<double> genRandomMagnitudes(long seed, long count)
+{
+   std::default_random_engine engine;
+  engine.seed(seed);
+  std::uniform_real_distribution<double> rexp(-8.0, +8.0);
+  std::bernoulli_distribution rsign(0.5);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c)
+      data.push_back((rsign(engine) ? -1.0 : 1.0) * ::pow(10.0, rexp(engine)));
+
+   return data;
+}
+
 static void double_plus_assign_rand(benchmark::State &state)
 {
    
@@ -171,18 +187,21 @@ BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, double)
    ->Args({1, 0}) // 1 iter - seed 0
    ->Args({16, 0}) // 16 iter - seed 0
    ->Args({64, 0}) // 64 iter - seed 0
+   ->Args({1024, 0}) // 1024 iter - seed 0
 ;
 
 BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, kfloat64)
    ->Args({1, 0}) // 1 iter - seed 0
    ->Args({16, 0}) // 16 iter - seed 0
    ->Args({64, 0}) // 64 iter - seed 0
+   ->Args({1024, 0}) // 1024 iter - seed 0
 ;
 
 BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, nfloat64)
    ->Args({1, 0}) // 1 iter - seed 0
    ->Args({16, 0}) // 16 iter - seed 0
    ->Args({64, 0}) // 64 iter - seed 0
+   ->Args({1024, 0}) // 1024 iter - seed 0
 ;
 
 BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, long double)
@@ -201,4 +220,47 @@ BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, nfloat128)
    ->Args({1, 0}) // 1 iter - seed 0
    ->Args({16, 0}) // 16 iter - seed 0
    ->Args({64, 0}) // 64 iter - seed 0
-;
\ No newline at end of file
+;
+
+BENCHMARK_TEMPLATE(t_plus_assign_final_clobber, sfloat64)
+   ->Args({1, 0}) // 1 iter - seed 0
+   ->Args({16, 0}) // 16 iter - seed 0
+   ->Args({64, 0}) // 64 iter - seed 0
+;
+
+// templated benchmarks (random magnitudes, see 'genRandomMagnitudes')
+template <class F> 
+static void t_plus_assign_rand_magnitude(benchmark::State &state)
+{
+   std::vector<double> data = genRandomMagnitudes(state.range(1), state.range(0));
+   for (auto _ : state) 
+   {
+      F f = 0; // accumulator
+      for(double v: data)
+        f += v;
+      F f2;
+      benchmark::DoNotOptimize(f2 = f);
+      benchmark::ClobberMemory();
+   }
+}
+
+BENCHMARK_TEMPLATE(t_plus_assign_rand_magnitude, double)
+   ->Args({64, 0}) // 64 values - seed 0
+   ->Args({4096, 0}) // 4096 values - seed 0
+;
+
+BENCHMARK_TEMPLATE(t_plus_assign_rand_magnitude, kfloat64)
+   ->Args({64, 0}) // 64 values - seed 0
+   ->Args({4096, 0}) // 4096 values - seed 0
+;
+
+BENCHMARK_TEMPLATE(t_plus_assign_rand_magnitude, nfloat64)
+   ->Args({64, 0}) // 64 values - seed 0
+   ->Args({4096, 0}) // 4096 values - seed 0
+;
+
+BENCHMARK_TEMPLATE(t_plus_assign_rand_magnitude, nbfloat64)
+   ->Args({64, 0}) // 64 values - seed 0
+   ->Args({4096, 0}) // 4096 values - seed 0
+;
+
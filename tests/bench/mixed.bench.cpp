@@ -0,0 +1,47 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/mixed.hpp> // from 'src'
+
+using namespace kahan;
+
+template <class X>
+static std::vector<X> genMixedData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   std::vector<X> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(X(runif(engine)));
+   return data;
+}
+
+// X inputs into T lanes (float into double is widened in registers)
+template <class X, class T>
+static void bulk_sum_mixed(benchmark::State &state)
+{
+   std::vector<X> data = genMixedData<X>(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum<T>(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(bulk_sum_mixed, double, double)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bulk_sum_mixed, float, double)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bulk_sum_mixed, double, float)->Arg(1 << 16);
+
+// double inputs into float lanes, split in (hi, lo)
+static void bulk_sum_narrow_mixed(benchmark::State &state)
+{
+   std::vector<double> data = genMixedData<double>(state.range(0));
+   double lost;
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum_narrow(data.data(), data.size(), lost));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(bulk_sum_narrow_mixed)->Arg(1 << 16);
@@ -0,0 +1,62 @@
+#include <cmath>
+#include <vector>
+#include <random>
+
+#include <kahan-float/kahan.hpp> // from 'src'
+#include <kahan-float/norm.hpp> // from 'src'
+
+using namespace kahan;
+
+static std::vector<double> genNormData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(runif(engine));
+   return data;
+}
+
+// sqrt of sum of squares, one accumulator object (reference)
+template <class F>
+static void loop_norm2(benchmark::State &state)
+{
+   std::vector<double> data = genNormData(state.range(0));
+   for (auto _ : state) 
+   {
+      F f = 0;
+      for(double v: data)
+         f += v * v;
+      benchmark::DoNotOptimize(std::sqrt(double(f)));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_norm2, double)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(loop_norm2, kfloat64)->Arg(1 << 16);
+
+static void comp_norm2(benchmark::State &state)
+{
+   std::vector<double> data = genNormData(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(norm2(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(comp_norm2)->Arg(1 << 16);
+
+// same data, scaled out of the safe range (Blue's algorithm)
+static void comp_norm2_scaled(benchmark::State &state)
+{
+   std::vector<double> data = genNormData(state.range(0));
+   for(double& v: data)
+      v *= 1e300;
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(norm2(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(comp_norm2_scaled)->Arg(1 << 16);
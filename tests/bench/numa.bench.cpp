@@ -0,0 +1,45 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/numa.hpp> // from 'src'
+
+using namespace kahan;
+
+// first touch by the threads that will read each range (pages of
+// 'numa_buffer' are untouched until then)
+static numa_buffer<double> genNumaData(long count, const std::vector<numa_node>& nodes)
+{
+   numa_buffer<double> data(count);
+   numa_for(data.size(), nodes, 0, [&data](const numa_range& r) {
+      std::default_random_engine engine(unsigned(r.index));
+      std::uniform_real_distribution<double> runif(-1, +1);
+      for (std::size_t i = r.begin; i < r.end; i++)
+         data[i] = runif(engine);
+   });
+   return data;
+}
+
+static void sum_numa(benchmark::State &state)
+{
+   std::vector<numa_node> nodes = numa_nodes();
+   numa_buffer<double> data = genNumaData(state.range(0), nodes);
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(numa_sum<double>(data.data(), data.size(), nodes));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(sum_numa)->Arg(1 << 24);
+
+// same data, static chunks (no binding)
+static void sum_numa_unbound(benchmark::State &state)
+{
+   std::vector<numa_node> nodes = numa_nodes();
+   numa_buffer<double> data = genNumaData(state.range(0), nodes);
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(parallel_sum<double>(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(sum_numa_unbound)->Arg(1 << 24);
@@ -0,0 +1,55 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/pool.hpp> // from 'src'
+
+using namespace kahan;
+
+// skewed rows: row 0 has half of all elements
+static std::vector<std::vector<double>> genRaggedData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1, +1);
+
+   std::vector<std::vector<double>> rows(64);
+   rows[0].resize(count / 2);
+   for(size_t r=1; r<rows.size(); ++r)
+      rows[r].resize(count / 2 / (rows.size() - 1));
+   for (auto& row : rows)
+      for (auto& v : row)
+         v = runif(engine);
+   return rows;
+}
+
+// one task per row (heavy row runs alone)
+static void ragged_rows_pool(benchmark::State &state)
+{
+   std::vector<std::vector<double>> data = genRaggedData(state.range(0));
+   std::vector<const double*> rows;
+   std::vector<std::size_t> len;
+   for (auto& r : data) { rows.push_back(r.data()); len.push_back(r.size()); }
+   work_pool pool;
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(ragged_sum<double>(pool, rows.data(), len.data(), rows.size(), nullptr, std::size_t(state.range(0))));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(ragged_rows_pool)->Arg(1 << 22);
+
+// long rows split in tasks (stolen by idle threads)
+static void ragged_split_pool(benchmark::State &state)
+{
+   std::vector<std::vector<double>> data = genRaggedData(state.range(0));
+   std::vector<const double*> rows;
+   std::vector<std::size_t> len;
+   for (auto& r : data) { rows.push_back(r.data()); len.push_back(r.size()); }
+   work_pool pool;
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(ragged_sum<double>(pool, rows.data(), len.data(), rows.size(), nullptr));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(ragged_split_pool)->Arg(1 << 22);
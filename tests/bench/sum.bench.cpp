@@ -0,0 +1,75 @@
+#include <vector>
+#include <random>
+
+#include <kahan-float/multiproc.hpp> // from 'src'
+#include <kahan-float/parallel.hpp> // from 'src'
+#include <kahan-float/sum.hpp> // from 'src'
+
+using namespace kahan;
+
+static std::vector<double> genSumData(long count)
+{
+   std::default_random_engine engine;
+  engine.seed(0);
+  std::uniform_real_distribution<double> runif(-1000, +1000);
+
+   std::vector<double> data;
+   for(long c=0; c<count; ++c)
+      data.push_back(runif(engine));
+   return data;
+}
+
+// element by element (reference)
+template <class F>
+static void loop_sum_array(benchmark::State &state)
+{
+   std::vector<double> data = genSumData(state.range(0));
+   for (auto _ : state) 
+   {
+      F f = 0;
+      for(double v: data)
+         f += v;
+      F f2;
+      benchmark::DoNotOptimize(f2 = f);
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK_TEMPLATE(loop_sum_array, double)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(loop_sum_array, nfloat64)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(loop_sum_array, nbfloat64)->Arg(1 << 16);
+
+static void bulk_sum_array(benchmark::State &state)
+{
+   std::vector<double> data = genSumData(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(bulk_sum<double>(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(bulk_sum_array)->Arg(1 << 16);
+
+static void parallel_sum_array(benchmark::State &state)
+{
+   std::vector<double> data = genSumData(state.range(0));
+   for (auto _ : state) 
+   {
+      benchmark::DoNotOptimize(parallel_sum<double>(data.data(), data.size()));
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(parallel_sum_array)->Arg(1 << 22)->UseRealTime();
+
+// same split over processes (includes fork and shared memory setup)
+static void process_sum_array(benchmark::State &state)
+{
+   std::vector<double> data = genSumData(state.range(0));
+   for (auto _ : state) 
+   {
+      nbfloat64 r;
+      process_sum<double>(data.data(), data.size(), r, 2);
+      benchmark::DoNotOptimize(r);
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(process_sum_array)->Arg(1 << 22)->UseRealTime();
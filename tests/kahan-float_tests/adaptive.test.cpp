@@ -0,0 +1,117 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/adaptive.hpp>  // 'src' included
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+
+using namespace std;
+using namespace kahan;
+
+// correctly rounded |exact sum of x - v|
+static double exact_error(const std::vector<double>& x, double v) {
+  sfloat64 s;
+  for (double e : x) s += e;
+  s += -v;
+  return std::fabs(s.getValue());
+}
+
+TEST_CASE("Adaptive Tests well-conditioned stays kahan") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(0, 1);
+  std::vector<double> x(10000);
+  for (double& v : x) v = runif(engine);
+  afloat64 a;
+  kfloat64 k;
+  for (double v : x) {
+    a += v;
+    k += v;
+  }
+  REQUIRE(a.getMode() == adaptive_mode::kahan);
+  REQUIRE(a.getValue() == k.getValue());  // same steps as kfloat64
+  REQUIRE(a.getCount() == x.size());
+  REQUIRE(exact_error(x, a.getValue()) <= a.error_bound());
+  afloat64 b;
+  b.add(x.data(), x.size());
+  REQUIRE(b.getMode() == adaptive_mode::kahan);
+  REQUIRE(b.getValue() == k.getValue());
+}
+
+TEST_CASE("Adaptive Tests escalation") {
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  // mixed signs: neumaier is enough
+  std::vector<double> x(10000);
+  for (double& v : x) v = runif(engine) + 0.1;
+  afloat64 a;
+  a.add(x.data(), x.size());
+  REQUIRE(a.getMode() == adaptive_mode::neumaier);
+  REQUIRE(exact_error(x, a.getValue()) <= a.error_bound());
+  REQUIRE(a.error_bound() < 1e-12);
+
+  // large cancelling pairs: exact, and bulk add switches before any loss
+  std::vector<double> y(10000);
+  for (size_t i = 0; i < y.size(); i += 2) {
+    y[i] = runif(engine) * 1e16;
+    y[i + 1] = -y[i] + runif(engine);
+  }
+  afloat64 b;
+  b.add(y.data(), y.size());
+  REQUIRE(b.getMode() == adaptive_mode::exact);
+  REQUIRE(exact_error(y, b.getValue()) == 0.0);
+  // element by element: switches at first check, keeps earlier errors
+  afloat64 c;
+  kfloat64 k;
+  for (double v : y) {
+    c += v;
+    k += v;
+  }
+  REQUIRE(c.getMode() == adaptive_mode::exact);
+  REQUIRE(exact_error(y, c.getValue()) <= c.error_bound());
+  REQUIRE(exact_error(y, c.getValue()) < exact_error(y, k.getValue()));
+}
+
+TEST_CASE("Adaptive Tests double-double") {
+  // moderate cancellation of many terms: double-double is enough
+  std::default_random_engine engine(2);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> x(4096);
+  for (size_t i = 0; i < x.size(); i++) x[i] = runif(engine) * 1e6;
+  sfloat64 s;
+  for (double v : x) s += v;
+  x.push_back(-s.getValue() + 1.0);  // sum is about 1
+  afloat64 a;
+  a.add(x.data(), x.size());
+  REQUIRE(a.getMode() == adaptive_mode::double_double);
+  REQUIRE(exact_error(x, a.getValue()) <= a.error_bound());
+  REQUIRE(a.error_bound() < 1e-12);
+}
+
+TEST_CASE("Adaptive Tests special values") {
+  const double inf = std::numeric_limits<double>::infinity();
+  afloat64 a = 1.0;
+  a += inf;
+  a += 2.0;
+  REQUIRE(a.getMode() == adaptive_mode::exact);
+  REQUIRE(a.getValue() == inf);
+  REQUIRE(a.error_bound() == inf);
+  a -= inf;
+  REQUIRE(std::isnan(a.getValue()));
+  std::vector<double> x{1.0, std::numeric_limits<double>::quiet_NaN(), 2.0};
+  afloat64 b;
+  b.add(x.data(), x.size());
+  REQUIRE(std::isnan(b.getValue()));
+  // float (kfloat32 gives 0)
+  std::vector<float> y{1e8f, 1.0f, -1e8f};
+  afloat32 f;
+  f.add(y.data(), y.size());
+  REQUIRE(f.getValue() == 1.0f);
+}
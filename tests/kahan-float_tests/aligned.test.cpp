@@ -0,0 +1,109 @@
+#include <atomic>
+#include <limits>  // numeric_limits
+#include <new>     // bad_alloc
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/aligned.hpp>  // 'src' included
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/merge.hpp>
+#include <kahan-float/neumaier.hpp>
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Aligned Tests layout") {
+  REQUIRE(sizeof(padded<kfloat64>) == cache_line);
+  REQUIRE(alignof(padded<kfloat64>) == cache_line);
+  REQUIRE(sizeof(padded<nfloat32, 32>) == 32);
+  REQUIRE(alignof(lane_accumulator<double>) == 64);
+  REQUIRE(alignof(lane_accumulator<float>) == 64);
+
+  aligned_vector<double> x(1001, 0.1);
+  REQUIRE(is_aligned(x.data(), cache_line));
+  aligned_vector<float, 32> y(3);
+  REQUIRE(is_aligned(y.data(), 32));
+  aligned_vector<char, 256> z(1);
+  REQUIRE(is_aligned(z.data(), 256));
+  // over-aligned elements are aligned too
+  aligned_vector<padded<kfloat64>> p(17);
+  for (auto& a : p) REQUIRE(is_aligned(&a, cache_line));
+}
+
+TEST_CASE("Aligned Tests padded accumulators") {
+  // used as the accumulator itself
+  padded<nfloat64> a;
+  a += 1e16;
+  a += 1.0;
+  a -= 1e16;
+  REQUIRE(a.getValue() == 1.0);
+  padded<kfloat64> k(0.5);
+  kfloat64 plain(0.5);
+  k += 0.1;
+  plain += 0.1;
+  REQUIRE(k == plain);
+  padded<kfloat64> m(kfloat64(1.0, 0.25));
+  REQUIRE(m.getC() == 0.25);
+  merge(k, m);
+  merge(plain, kfloat64(1.0, 0.25));
+  REQUIRE(k == plain);
+
+  // one per thread, concurrent updates
+  const int threads = 4;
+  aligned_vector<padded<nfloat64>> part(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++)
+    workers.emplace_back([&part, t]() {
+      for (int i = 0; i < 100000; i++) part[t] += 0.1 * t;
+    });
+  for (auto& w : workers) w.join();
+  nfloat64 serial;
+  for (int i = 0; i < 100000; i++) serial += 0.1 * 3;
+  REQUIRE(part[3].getValue() == serial.getValue());
+}
+
+TEST_CASE("Aligned Tests lane accumulator") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  aligned_vector<double> x(100003);
+  for (size_t i = 0; i < x.size(); i++)
+    x[i] = runif(engine) * ((i % 7 == 0) ? 1e12 : 1.0);
+  const double exact = fsum(x.data(), x.size());
+
+  // chunks of multiples of the lanes give the single call result
+  lane_accumulator<double> acc;
+  const size_t chunk = lane_accumulator<double>::lanes * 100;
+  for (size_t i = 0; i < x.size(); i += chunk)
+    acc.add(x.data() + i, (x.size() - i < chunk) ? x.size() - i : chunk);
+  REQUIRE(acc.getSum() == bulk_sum<double>(x.data(), x.size()));
+  REQUIRE(acc.getValue() == exact);
+  acc.clear();
+  REQUIRE(acc.getValue() == 0.0);
+
+  // float input, double lanes
+  aligned_vector<float, 32> f(1000, 0.1f);
+  lane_accumulator<double> d;
+  d.add(f.data(), f.size());
+  REQUIRE(d.getValue() == bulk_sum<double>(f.data(), f.size()).getValue());
+}
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+
+TEST_CASE("Aligned Tests allocation failure") {
+  // like std::allocator (never a null pointer); sizes that overflow fail
+  // before 'posix_memalign' (sanitizers abort on huge requests)
+  aligned_allocator<double> a;
+  const std::size_t max = std::numeric_limits<std::size_t>::max();
+  REQUIRE_THROWS_AS(a.allocate(max), std::bad_alloc);
+  REQUIRE_THROWS_AS(a.allocate(max / sizeof(double) + 1), std::bad_alloc);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/async.hpp>  // 'src' included
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/neumaier.hpp>
+
+using namespace std;
+using namespace kahan;
+
+#if KAHAN_HAS_COROUTINES
+
+// 'n' values 'v' (between +1e8 and -1e8), in chunks of 'b'
+static chunk_generator<double> generate(double v, std::size_t n,
+                                        std::size_t b) {
+  std::size_t i = 0;
+  while (i < n) {
+    double* p = co_await next_buffer<double>{b};
+    std::size_t k = 0;
+    for (; k < b && i < n; k++, i++)
+      p[k] = (i % 3 == 0) ? v : (i % 3 == 1) ? 1e8 : -1e8;
+    co_yield chunk<double>{p, k};
+  }
+}
+
+TEST_CASE("Async Tests generated sources") {
+  sfloat64 exact;
+  for (std::size_t i = 0; i < 100003; i++)
+    exact += (i % 3 == 0) ? 0.1 : (i % 3 == 1) ? 1e8 : -1e8;
+
+  nfloat64 one = stream_sum<nfloat64>(generate(0.1, 100003, 1000));
+  REQUIRE(std::fabs(one.getValue() - exact.getValue()) <=
+          std::ldexp(exact.getValue(), -52));
+
+  // several sources, merged in order (same result on every run)
+  std::vector<chunk_generator<double>> sources;
+  sources.push_back(generate(0.1, 100003, 1000));
+  sources.push_back(generate(0.2, 50000, 77));
+  sources.push_back(generate(0.3, 0, 10));  // empty
+  sources.push_back(generate(0.1, 100003, 4096));
+  nfloat64 all = stream_sum<nfloat64>(sources);
+  sfloat64 exact2;
+  for (std::size_t i = 0; i < 50000; i++)
+    exact2 += (i % 3 == 0) ? 0.2 : (i % 3 == 1) ? 1e8 : -1e8;
+  exact2 += exact.getValue();
+  exact2 += exact.getValue();
+  REQUIRE(std::fabs(all.getValue() - exact2.getValue()) <=
+          std::ldexp(exact2.getValue(), -52));
+  for (int r = 0; r < 3; r++) {
+    std::vector<chunk_generator<double>> again;
+    again.push_back(generate(0.1, 100003, 1000));
+    again.push_back(generate(0.2, 50000, 77));
+    again.push_back(generate(0.3, 0, 10));
+    again.push_back(generate(0.1, 100003, 4096));
+    REQUIRE(stream_sum<nfloat64>(again) == all);
+  }
+
+  // into an existing accumulator
+  kfloat64 k = 1.0;
+  std::vector<chunk_generator<double>> none;
+  stream_add(k, none);
+  REQUIRE(k.getValue() == 1.0);
+}
+
+TEST_CASE("Async Tests file source") {
+  std::FILE* f = std::tmpfile();
+  REQUIRE(f != nullptr);
+  std::vector<float> x(10007, 0.1f);
+  REQUIRE(std::fwrite(x.data(), sizeof(float), x.size(), f) == x.size());
+  std::rewind(f);
+  nfloat64 s = stream_sum<nfloat64>(read_chunks<float>(f, 512));
+  REQUIRE(s.getValue() == 10007 * double(0.1f));
+  REQUIRE(!std::ferror(f));
+  std::fclose(f);
+}
+
+#endif  // KAHAN_HAS_COROUTINES
@@ -0,0 +1,102 @@
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/csv.hpp>       // 'src' included
+#include <kahan-float/neumaier.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("CSV Tests columns with header") {
+  std::string text = "a,b,c\n0.1,1,x\n0.1,1e100,2\r\n0.1, 1 ,3\n0.1,-1e100,\n";
+  csv_sum<nfloat64> s(',', true);
+  s.feed(text.data(), text.size());
+  s.finish();
+  REQUIRE(s.rows() == 4);
+  REQUIRE(s.errors() == 1);  // 'x'
+  REQUIRE(s.columns().size() == 3);
+  REQUIRE(s.columns()[0].getValue() == 0.4);
+  REQUIRE(s.columns()[1].getValue() == 2.0);
+  REQUIRE(s.columns()[2].getValue() == 5.0);
+}
+
+TEST_CASE("CSV Tests any chunk split") {
+  std::string text;
+  for (int i = 0; i < 100; i++) text += "0.1;+2.5e-1;-3\n";
+  text += "1;1;1";  // no final line break
+  for (std::size_t chunk = 1; chunk < 40; chunk += 3) {
+    csv_sum<nfloat64> s(';');
+    for (std::size_t p = 0; p < text.size(); p += chunk)
+      s.feed(text.data() + p, std::min(chunk, text.size() - p));
+    s.finish();
+    REQUIRE(s.rows() == 101);
+    REQUIRE(s.errors() == 0);
+    REQUIRE(s.columns()[0].getValue() == 11.0);
+    REQUIRE(s.columns()[1].getValue() == 26.0);
+    REQUIRE(s.columns()[2].getValue() == -299.0);
+  }
+}
+
+TEST_CASE("CSV Tests from stream") {
+  std::stringstream ss;
+  for (int i = 0; i < 1000; i++) ss << "0.1\t" << i << "\n";
+  csv_sum<nfloat64> s('\t');
+  REQUIRE(sum_csv(ss, s, 64));  // small buffer, many chunks
+  REQUIRE(s.rows() == 1000);
+  REQUIRE(s.columns()[0].getValue() == 100.0);
+  REQUIRE(s.columns()[1].getValue() == 499500.0);
+}
+
+TEST_CASE("CSV Tests invalid numbers") {
+  std::string text = "1e,--1,0x,1.5.5,nan\n";
+  csv_sum<nfloat64> s;
+  s.feed(text.data(), text.size());
+  s.finish();
+  REQUIRE(s.errors() == 4);
+  REQUIRE(s.columns().size() == 5);
+  REQUIRE(std::isnan(s.columns()[4].getValue()));
+}
+
+TEST_CASE("CSV Tests signs") {
+  double v = 0;
+  REQUIRE(detail::parse_double("+5", "+5" + 2, v));
+  REQUIRE(v == 5.0);
+  REQUIRE(!detail::parse_double("+-5", "+-5" + 3, v));
+  REQUIRE(!detail::parse_double("++5", "++5" + 3, v));
+  REQUIRE(!detail::parse_double("+", "+" + 1, v));
+  REQUIRE(!detail::parse_double("+-1e400", "+-1e400" + 7, v));
+}
+
+TEST_CASE("CSV Tests fast path matches strtod") {
+  const char* nums[] = {"0.1",   "-2.5e-3",   "123456789012345678", ".5",
+                        "7.",    "1e22",      "9007199254740993",  "1e-22",
+                        "1e23",  "-0",        "4.9e-324",          "1.7e308",
+                        "0.3e1", "1234.5678", "0.30000000000000004"};
+  for (const char* s : nums) {
+    double v = 0;
+    REQUIRE(detail::parse_double(s, s + std::strlen(s), v));
+    REQUIRE(v == std::strtod(s, nullptr));
+    REQUIRE(std::signbit(v) == std::signbit(std::strtod(s, nullptr)));
+  }
+}
+
+TEST_CASE("CSV Tests decimal point in any locale") {
+  if (!std::setlocale(LC_NUMERIC, "de_DE.UTF-8")) return;  // not installed
+  const char* s = "0.10000000000000000000001";  // not in the fast path
+  double v = 0;
+  bool ok = detail::parse_double(s, s + std::strlen(s), v);
+  bool comma = detail::parse_double("1,5", "1,5" + 3, v);
+  std::setlocale(LC_NUMERIC, "C");
+  REQUIRE(ok);
+  REQUIRE(!comma);
+}
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <limits>  // numeric_limits
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/eft.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// random floats with exponents in [-20, 20] (sums and products of two of
+// them are exact in double, which is used as reference)
+static std::vector<float> random_floats(unsigned seed, std::size_t n) {
+  std::default_random_engine engine(seed);
+  std::uniform_real_distribution<float> rmant(-1.0f, 1.0f);
+  std::uniform_int_distribution<int> rexp(-20, 20);
+  std::vector<float> v(n);
+  for (std::size_t i = 0; i < n; i++)
+    v[i] = ::ldexpf(rmant(engine), rexp(engine));
+  return v;
+}
+
+TEST_CASE("EFT Tests two_sum float exact") {
+  std::vector<float> a = random_floats(0, 1000);
+  std::vector<float> b = random_floats(1, 1000);
+  for (std::size_t i = 0; i < a.size(); i++) {
+    float s, e;
+    eft::two_sum(a[i], b[i], s, e);
+    REQUIRE(s == a[i] + b[i]);
+    REQUIRE((double)s + (double)e == (double)a[i] + (double)b[i]);
+  }
+}
+
+TEST_CASE("EFT Tests fast_two_sum float exact when |a| >= |b|") {
+  std::vector<float> a = random_floats(2, 1000);
+  std::vector<float> b = random_floats(3, 1000);
+  for (std::size_t i = 0; i < a.size(); i++) {
+    float x = a[i], y = b[i];
+    if (::fabs(x) < ::fabs(y)) std::swap(x, y);
+    float s, e, s2, e2;
+    eft::fast_two_sum(x, y, s, e);
+    eft::two_sum(x, y, s2, e2);
+    REQUIRE(s == s2);
+    REQUIRE(e == e2);
+  }
+}
+
+TEST_CASE("EFT Tests two_prod float exact") {
+  std::vector<float> a = random_floats(4, 1000);
+  std::vector<float> b = random_floats(5, 1000);
+  for (std::size_t i = 0; i < a.size(); i++) {
+    float p, e, p2, e2;
+    eft::two_prod(a[i], b[i], p, e);
+    REQUIRE(p == a[i] * b[i]);
+    REQUIRE((double)p + (double)e == (double)a[i] * (double)b[i]);
+    // both product algorithms agree
+    eft::two_prod_dekker(a[i], b[i], p2, e2);
+    REQUIRE(p2 == p);
+    REQUIRE(e2 == e);
+    eft::two_prod_fma(a[i], b[i], p2, e2);
+    REQUIRE(p2 == p);
+    REQUIRE(e2 == e);
+  }
+}
+
+TEST_CASE("EFT Tests double known values") {
+  // 1 + 1e100: error is the lost '1'
+  double s, e;
+  eft::two_sum(1.0, 1e100, s, e);
+  REQUIRE(s == 1e100);
+  REQUIRE(e == 1.0);
+
+  // (1 + 2^-30)^2 = 1 + 2^-29 + 2^-60
+  double a = 1.0 + ::ldexp(1.0, -30);
+  double p;
+  eft::two_prod(a, a, p, e);
+  REQUIRE(p == 1.0 + ::ldexp(1.0, -29));
+  REQUIRE(e == ::ldexp(1.0, -60));
+
+  // split halves are narrow: their squares are exact
+  double hi, lo;
+  eft::split(0.1, hi, lo);
+  REQUIRE(hi + lo == 0.1);
+  REQUIRE(std::fma(hi, hi, -(hi * hi)) == 0.0);
+  REQUIRE(std::fma(lo, lo, -(lo * lo)) == 0.0);
+}
+
+TEST_CASE("EFT Tests batch versions match scalar") {
+  std::vector<float> fa = random_floats(6, 257);
+  std::vector<float> fb = random_floats(7, 257);
+  std::vector<double> a(fa.begin(), fa.end());
+  std::vector<double> b(fb.begin(), fb.end());
+  for (std::size_t i = 0; i < a.size(); i++) {
+    a[i] *= 1.0 + ::ldexp(1.0, -40);  // use all double bits
+    b[i] = ::ldexp(b[i], (int)(i % 64) - 32);
+  }
+  const std::size_t n = a.size();
+  std::vector<double> s(n), e(n), hi(n), lo(n);
+
+  eft::two_sum(a.data(), b.data(), s.data(), e.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    double s1, e1;
+    eft::two_sum(a[i], b[i], s1, e1);
+    REQUIRE(s[i] == s1);
+    REQUIRE(e[i] == e1);
+  }
+
+  eft::two_prod(a.data(), b.data(), s.data(), e.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    double p1, e1;
+    eft::two_prod(a[i], b[i], p1, e1);
+    REQUIRE(s[i] == p1);
+    REQUIRE(e[i] == e1);
+  }
+
+  eft::split(a.data(), hi.data(), lo.data(), n);
+  for (std::size_t i = 0; i < n; i++) REQUIRE(hi[i] + lo[i] == a[i]);
+
+  std::vector<float> fs(n), fe(n);
+  eft::fast_two_sum(fa.data(), fb.data(), fs.data(), fe.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    float s1, e1;
+    eft::fast_two_sum(fa[i], fb[i], s1, e1);
+    REQUIRE(fs[i] == s1);
+    REQUIRE(fe[i] == e1);
+  }
+}
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fixed.hpp>  // 'src' included
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Fixed Tests 128-bit integer sums") {
+  const std::int64_t big = std::numeric_limits<std::int64_t>::max();
+  const std::int64_t small = std::numeric_limits<std::int64_t>::min();
+  ifixed128 s;
+  REQUIRE(s.getValue() == 0.0);
+  s += 1;
+  REQUIRE(s.getHi() == 0);
+  REQUIRE(s.getLo() == 1u);
+  s -= 2;
+  REQUIRE(s.getHi() == -1);
+  REQUIRE(s.getLo() == ~std::uint64_t(0));
+  REQUIRE(s.getValue() == -1.0);
+  // carries beyond 64 bits, and back
+  ifixed128 t;
+  for (int i = 0; i < 4; i++) t += big;
+  REQUIRE(t.getHi() == 1);
+  REQUIRE(t.getValue() == 4 * std::ldexp(1.0, 63) - 4);
+  for (int i = 0; i < 4; i++) t -= big;
+  REQUIRE(t == ifixed128());
+  t += small;
+  t += small;
+  REQUIRE(t.getValue() == -std::ldexp(1.0, 64));
+  REQUIRE(-t == ifixed128(1, 0));
+  REQUIRE(t < ifixed128());
+  REQUIRE(ifixed128(1, 0) > ifixed128(0, ~std::uint64_t(0)));
+  // merge
+  REQUIRE((ifixed128(5) + ifixed128(-7)).getValue() == -2.0);
+  // correctly rounded on read: 2^64 + 1 is not a double
+  ifixed128 r(1, 1);
+  REQUIRE(r.getValue() == std::ldexp(1.0, 64));
+  REQUIRE(r.getKahan().getC() == -1.0);
+}
+
+TEST_CASE("Fixed Tests 64-bit edge values") {
+  const std::uint64_t umax = std::numeric_limits<std::uint64_t>::max();
+  const std::int64_t small = std::numeric_limits<std::int64_t>::min();
+  ifixed128 s;
+  s += std::uint64_t(1) << 63;  // not negative
+  REQUIRE(s.getHi() == 0);
+  REQUIRE(s.getValue() == std::ldexp(1.0, 63));
+  s += umax;
+  REQUIRE(s.getHi() == 1);
+  REQUIRE(s == ifixed128(1, (std::uint64_t(1) << 63) - 1));
+  s -= umax;
+  s -= std::uint64_t(1) << 63;
+  REQUIRE(s == ifixed128());
+  // INT64_MIN negated in 128 bits
+  s -= small;
+  REQUIRE(s == ifixed128(0, std::uint64_t(1) << 63));
+  REQUIRE(s.getValue() == std::ldexp(1.0, 63));
+  s += small;
+  REQUIRE(s == ifixed128());
+  // narrow types
+  s += static_cast<unsigned char>(200);
+  s += static_cast<short>(-300);
+  s -= 4000000000u;
+  REQUIRE(s.getValue() == -4000000100.0);
+}
+
+TEST_CASE("Fixed Tests bulk add") {
+  std::default_random_engine engine(0);
+  std::uniform_int_distribution<std::int64_t> rint(
+      std::numeric_limits<std::int64_t>::min(),
+      std::numeric_limits<std::int64_t>::max());
+  std::vector<std::int64_t> x(100003);
+  ifixed128 each;
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = rint(engine);
+    each += x[i];
+  }
+  ifixed128 bulk;
+  bulk.add(x.data(), x.size());
+  REQUIRE(bulk == each);
+  // in parts, with tails
+  ifixed128 parts;
+  parts.add(x.data(), 13);
+  parts.add(x.data() + 13, x.size() - 13);
+  REQUIRE(parts == each);
+  ifixed128 none(3);
+  none.add(x.data(), 0);
+  REQUIRE(none.getValue() == 3.0);
+  // cancels exactly
+  std::vector<std::int64_t> y(x);
+  for (size_t i = 0; i < x.size(); i++) y.push_back(-x[i]);
+  ifixed128 zero;
+  zero.add(y.data(), y.size());
+  REQUIRE(zero == ifixed128());
+}
+
+TEST_CASE("Fixed Tests decimal cents") {
+  // 0.01 is not a double: summing cents in double drifts
+  const int n = 1000003;
+  cfixed128 cents;
+  double naive = 0;
+  for (int i = 0; i < n; i++) {
+    cents += 1;
+    naive += 0.01;
+  }
+  REQUIRE(cents.getValue() == 10000.03);
+  REQUIRE(naive != 10000.03);
+  // compensated pair on read
+  kfloat64 k = cents.getKahan();
+  sfloat64 exact;
+  exact += k.getValue();
+  exact += -k.getC();
+  REQUIRE(std::fabs(exact.getValue() - 10000.03) <= 1e-12);
+  REQUIRE(k.getValue() == 10000.03);
+  // negative units
+  cfixed128 debt(-250);
+  REQUIRE(debt.getValue() == -2.5);
+}
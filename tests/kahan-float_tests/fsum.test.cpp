@@ -0,0 +1,168 @@
+#include <cmath>
+#include <limits>  // numeric_limits
+#include <sstream>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>  // 'src' included
+#include <kahan-float/merge.hpp>
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Fsum Tests sfloat64 empty == 0.0") {
+  sfloat64 s;
+  REQUIRE((double)s == 0.0);
+  REQUIRE(s.size() == 0);
+}
+
+TEST_CASE("Fsum Tests 10x 0.1 == 1.0") {
+  double f = 0.0;
+  for (unsigned i = 0; i < 10; i++) f += 0.1;
+  REQUIRE(f != 1.0);
+
+  sfloat64 s;
+  for (unsigned i = 0; i < 10; i++) s += 0.1;
+  REQUIRE((double)s == 1.0);
+}
+
+TEST_CASE("Fsum Tests [1,10^100, 1, -10^100]") {
+  sfloat64 s = 0;
+  s += 1;
+  s += 1e100;
+  s += 1;
+  s += -1e100;
+  REQUIRE(s == 2);
+
+  std::stringstream ss;
+  ss << s;
+  REQUIRE(ss.str() == "2");
+}
+
+TEST_CASE("Fsum Tests python test_fsum vectors") {
+  // same vectors as CPython 'test_math.testFsum'
+  std::vector<double> v1{1e100, 1.0, -1e100, 1e-100, 1e50, -1.0, -1e50};
+  REQUIRE(fsum(v1.begin(), v1.end()) == 1e-100);
+
+  std::vector<double> v2{::ldexp(1.0, 53), -0.5, -::ldexp(1.0, -54)};
+  REQUIRE(fsum(v2.data(), v2.size()) == ::ldexp(1.0, 53) - 1.0);
+
+  std::vector<double> v3{::ldexp(1.0, 53), 1.0, ::ldexp(1.0, -100)};
+  REQUIRE(fsum(v3.data(), v3.size()) == ::ldexp(1.0, 53) + 2.0);
+
+  std::vector<double> v4{::ldexp(1.0, 53) + 10.0, 1.0, ::ldexp(1.0, -100)};
+  REQUIRE(fsum(v4.data(), v4.size()) == ::ldexp(1.0, 53) + 12.0);
+
+  std::vector<double> v5{::ldexp(1.0, 53) - 4.0, 0.5, ::ldexp(1.0, -54)};
+  REQUIRE(fsum(v5.data(), v5.size()) == ::ldexp(1.0, 53) - 3.0);
+
+  std::vector<double> v6{1e16, 1., 1e-16};
+  REQUIRE(fsum(v6.data(), v6.size()) == 10000000000000002.0);
+
+  std::vector<double> v7{1e-16, 1., 1e16};
+  REQUIRE(fsum(v7.data(), v7.size()) == 10000000000000002.0);
+}
+
+TEST_CASE("Fsum Tests partials spill to heap") {
+  // values spread over the whole exponent range do not overlap
+  tshewchuk<double, 4> s;
+  sfloat64 s2;
+  std::vector<double> v;
+  for (int e = -1000; e <= 1000; e += 100) v.push_back(::ldexp(1.0, e));
+  s.add(v.begin(), v.end());
+  s2.add(v.begin(), v.end());
+  REQUIRE(s.size() == v.size());
+  REQUIRE((double)s == ::ldexp(1.0, 1000));
+
+  // copies keep all partials
+  tshewchuk<double, 4> s3 = s;
+  REQUIRE(s3.size() == s.size());
+  for (int i = (int)v.size() - 1; i >= 0; i--) s3 -= v[i];
+  REQUIRE((double)s3 == 0.0);
+  REQUIRE(s == s2.getValue());
+}
+
+TEST_CASE("Fsum Tests inf nan") {
+  const double inf = std::numeric_limits<double>::infinity();
+  sfloat64 s;
+  s += 1;
+  s += inf;
+  REQUIRE((double)s == inf);
+  s += -inf;
+  REQUIRE(std::isnan((double)s));
+
+  sfloat64 s2;
+  s2 += std::numeric_limits<double>::quiet_NaN();
+  s2 += 1;
+  REQUIRE(std::isnan((double)s2));
+
+  // intermediate overflow
+  sfloat64 s3;
+  s3 += std::numeric_limits<double>::max();
+  s3 += std::numeric_limits<double>::max();
+  REQUIRE((double)s3 == inf);
+  REQUIRE((double)(-s3) == -inf);
+}
+
+TEST_CASE("Fsum Tests adds after intermediate overflow") {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double max = std::numeric_limits<double>::max();
+  // back in range: exact again
+  std::vector<double> x{1e308, 1e308, -1e308};
+  REQUIRE(fsum(x.data(), x.size()) == 1e308);
+  std::vector<double> y{max, max, 1.0, -max, -max, 0.5};
+  REQUIRE(fsum(y.data(), y.size()) == 1.5);
+  std::vector<double> z{-max, -max, -max, max, max, 1e-300};
+  REQUIRE(fsum(z.data(), z.size()) == -max);
+
+  sfloat64 s;
+  s += 1e308;
+  s += 1e308;
+  REQUIRE(s.getOverflow() == 1);
+  REQUIRE((double)s == inf);
+  s += 1.0;
+  REQUIRE((double)s == inf);  // not nan
+  for (unsigned i = 0; i < s.size(); i++)
+    REQUIRE(std::isfinite(s.partial(i)));
+  s -= 1e308;
+  s -= 1.0;
+  REQUIRE((double)s == 1e308);
+  REQUIRE(-s == sfloat64(-1e308));
+  // many overflows
+  sfloat64 m;
+  for (int i = 0; i < 1000; i++) m += max;
+  REQUIRE((double)m == inf);
+  for (int i = 0; i < 999; i++) m -= max;
+  REQUIRE((double)m == max);
+  // merge keeps overflow
+  sfloat64 a, b;
+  a += max;
+  a += max;
+  b += -max;
+  b += -max;
+  b += 2.0;
+  merge(a, b);
+  REQUIRE((double)a == 2.0);
+
+  // float
+  sfloat32 f;
+  const float fmax = std::numeric_limits<float>::max();
+  f += fmax;
+  f += fmax;
+  f += 3.0f;
+  REQUIRE((float)f == std::numeric_limits<float>::infinity());
+  f -= fmax;
+  REQUIRE((float)f == fmax);
+}
+
+TEST_CASE("Fsum Tests sfloat32") {
+  sfloat32 s;
+  for (unsigned i = 0; i < 20; i++) s += 0.1f;
+  REQUIRE((float)s == 2.0f);
+  REQUIRE(-s < s);
+}
@@ -0,0 +1,137 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/gemm.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// correctly rounded (A B)(i, j), row-major
+static double exact_entry(const std::vector<double>& A,
+                          const std::vector<double>& B, size_t k, size_t n,
+                          size_t i, size_t j) {
+  sfloat64 s;
+  for (size_t p = 0; p < k; p++) {
+    double h, r;
+    eft::two_prod(A[i * k + p], B[p * n + j], h, r);
+    s += h;
+    s += r;
+  }
+  return s.getValue();
+}
+
+// transposed copy of a rows x cols row-major matrix
+static std::vector<double> transpose(const std::vector<double>& M,
+                                     size_t rows, size_t cols) {
+  std::vector<double> T(M.size());
+  for (size_t i = 0; i < rows; i++)
+    for (size_t j = 0; j < cols; j++) T[j * rows + i] = M[i * cols + j];
+  return T;
+}
+
+TEST_CASE("Gemm Tests double-double ill-conditioned") {
+  // sizes not multiple of blocks, k over more than one block
+  const size_t m = 7, n = 13, k = 600;
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> A(m * k), B(k * n);
+  for (double& v : B) v = runif(engine);
+  // pairs of cancelling products in each row of A
+  for (size_t i = 0; i < m; i++)
+    for (size_t p = 0; p < k; p++) {
+      double v = runif(engine);
+      if (p % 2 == 0)
+        v *= 1e10;
+      else
+        v -= A[i * k + p - 1] * B[(p - 1) * n + i % n] / B[p * n + i % n];
+      A[i * k + p] = v;
+    }
+
+  std::vector<double> C(m * n);
+  gemm(layout::row_major, gemm_mode::double_double, m, n, k, A.data(), k,
+       B.data(), n, C.data(), n, 1);
+  for (size_t i = 0; i < m; i++)
+    for (size_t j = 0; j < n; j++) {
+      double ref = exact_entry(A, B, k, n, i, j);
+      REQUIRE(std::fabs(C[i * n + j] - ref) <= 1e-15 * std::fabs(ref));
+    }
+
+  // same result in column-major
+  std::vector<double> At = transpose(A, m, k);
+  std::vector<double> Bt = transpose(B, k, n);
+  std::vector<double> Ct(m * n);
+  gemm(layout::col_major, gemm_mode::double_double, m, n, k, At.data(), m,
+       Bt.data(), k, Ct.data(), m, 1);
+  REQUIRE(transpose(Ct, n, m) == C);
+}
+
+TEST_CASE("Gemm Tests kahan mode") {
+  // integer entries: products are exact, only sums have errors
+  // (plain sums lose each small term between 1e17 and -1e17)
+  const size_t m = 5, n = 9, k = 300;
+  std::vector<double> A(m * k), B(k * n);
+  for (size_t i = 0; i < m; i++)
+    for (size_t p = 0; p < k; p++)
+      A[i * k + p] = (p % 3 == 0) ? 1e17 : ((p % 3 == 1) ? i + 1.0 : -1e17);
+  for (size_t p = 0; p < k; p++)
+    for (size_t j = 0; j < n; j++) B[p * n + j] = (p % 3 == 1) ? j : 1.0;
+
+  std::vector<double> C(m * n);
+  gemm(layout::row_major, gemm_mode::kahan, m, n, k, A.data(), k, B.data(),
+       n, C.data(), n, 1);
+  for (size_t i = 0; i < m; i++)
+    for (size_t j = 0; j < n; j++)
+      REQUIRE(C[i * n + j] == 100.0 * (i + 1) * j);
+}
+
+TEST_CASE("Gemm Tests threads and leading dimensions") {
+  const size_t m = 70, n = 1100, k = 40;  // more than one block of columns
+  const size_t lda = 41, ldb = 1103, ldc = 1101;
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> A(m * lda), B(k * ldb);
+  for (double& v : A) v = runif(engine);
+  for (double& v : B) v = runif(engine);
+
+  std::vector<double> C1(m * ldc, -1.0), C3(m * ldc, -1.0);
+  gemm(layout::row_major, gemm_mode::double_double, m, n, k, A.data(), lda,
+       B.data(), ldb, C1.data(), ldc, 1);
+  gemm(layout::row_major, gemm_mode::double_double, m, n, k, A.data(), lda,
+       B.data(), ldb, C3.data(), ldc, 3);
+  REQUIRE(C1 == C3);
+  // padding is not written
+  REQUIRE(C1[n] == -1.0);
+  std::vector<double> a(k), b(k);
+  for (size_t i = 0; i < m; i += 9)
+    for (size_t j = 0; j < n; j += 37) {
+      for (size_t p = 0; p < k; p++) {
+        a[p] = A[i * lda + p];
+        b[p] = B[p * ldb + j];
+      }
+      REQUIRE(std::fabs(C1[i * ldc + j] - dot2(a.data(), b.data(), k)) <=
+              1e-15 * std::fabs(C1[i * ldc + j]));
+    }
+}
+
+TEST_CASE("Gemm Tests float and empty") {
+  std::vector<float> A{1e8f, 1.0f, -1e8f};  // 1 x 3
+  std::vector<float> B{1.0f, 2.0f, 1.0f, 2.0f, 1.0f, 2.0f};  // 3 x 2
+  std::vector<float> C(2);
+  gemm(layout::row_major, gemm_mode::kahan, 1, 2, 3, A.data(), 3, B.data(),
+       2, C.data(), 2);
+  REQUIRE(C[0] == 1.0f);
+  REQUIRE(C[1] == 2.0f);
+  // k == 0 gives zeros
+  gemm(layout::row_major, gemm_mode::kahan, 1, 2, 0, A.data(), 3, B.data(),
+       2, C.data(), 2);
+  REQUIRE(C[0] == 0.0f);
+  REQUIRE(C[1] == 0.0f);
+}
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/gemv.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// correctly rounded dot product (exact products summed by fsum)
+static double exact_dot(const double* x, const double* y, size_t n) {
+  sfloat64 s;
+  for (size_t i = 0; i < n; i++) {
+    double p, e;
+    eft::two_prod(x[i], y[i], p, e);
+    s += p;
+    s += e;
+  }
+  return s.getValue();
+}
+
+TEST_CASE("Gemv Tests dot2 ill-conditioned") {
+  // plain dot product gives 0
+  std::vector<double> x{std::ldexp(1.0, 60), 3.0, -std::ldexp(1.0, 60)};
+  std::vector<double> y{1.0, 1.0, 1.0};
+  REQUIRE(dot2(x.data(), y.data(), 3) == 3.0);
+  // rounding error of a product is kept: (1 + 2^-30)^2 = 1 + 2^-29 + 2^-60
+  double a = 1.0 + std::ldexp(1.0, -30);
+  std::vector<double> u{a, -1.0, -std::ldexp(1.0, -29)};
+  std::vector<double> v{a, 1.0, 1.0};
+  REQUIRE(dot2(u.data(), v.data(), 3) == std::ldexp(1.0, -60));
+  // empty
+  REQUIRE(dot2(u.data(), v.data(), 0) == 0.0);
+}
+
+TEST_CASE("Gemv Tests row-major and column-major") {
+  const size_t m = 37;
+  const size_t n = 2500;  // more than one column block
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> A(m * n);   // row-major
+  std::vector<double> At(m * n);  // column-major
+  std::vector<double> x(n);
+  for (size_t j = 0; j < n; j++) x[j] = runif(engine);
+  for (size_t i = 0; i < m; i++)
+    for (size_t j = 0; j < n; j++) {
+      // pairs of large cancelling terms: plain double loses most digits
+      double v = runif(engine);
+      if (j % 2 == 0)
+        v *= 1e10;
+      else
+        v -= A[i * n + j - 1] * x[j - 1] / x[j];
+      A[i * n + j] = v;
+      At[j * m + i] = v;
+    }
+  std::vector<double> y(m), yt(m);
+  gemv(layout::row_major, m, n, A.data(), n, x.data(), y.data(), 1);
+  gemv(layout::col_major, m, n, At.data(), m, x.data(), yt.data(), 1);
+  for (size_t i = 0; i < m; i++) {
+    double ref = exact_dot(&A[i * n], x.data(), n);
+    REQUIRE(std::fabs(y[i] - ref) <= 1e-15 * std::fabs(ref));
+    REQUIRE(std::fabs(yt[i] - ref) <= 1e-15 * std::fabs(ref));
+    REQUIRE(y[i] == dot2(&A[i * n], x.data(), n));
+    double naive = 0;
+    for (size_t j = 0; j < n; j++) naive += A[i * n + j] * x[j];
+    REQUIRE(std::fabs(naive - ref) > 1e-9 * std::fabs(ref));
+  }
+}
+
+TEST_CASE("Gemv Tests leading dimension and threads") {
+  const size_t m = 3000;
+  const size_t n = 100;
+  const size_t lda = 103;
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> A(m * lda);
+  std::vector<double> x(n);
+  for (double& v : A) v = runif(engine);
+  for (double& v : x) v = runif(engine);
+
+  std::vector<double> y1(m), y3(m);
+  gemv(layout::row_major, m, n, A.data(), lda, x.data(), y1.data(), 1);
+  gemv(layout::row_major, m, n, A.data(), lda, x.data(), y3.data(), 3);
+  REQUIRE(y1 == y3);
+  for (size_t i = 0; i < m; i += 97)
+    REQUIRE(y1[i] == dot2(&A[i * lda], x.data(), n));
+
+  // same memory seen as column-major: lda x (m / lda * ...) columns
+  const size_t mc = 90;  // rows (<= lda)
+  const size_t nc = 50;  // columns
+  std::vector<double> yc1(mc), yc3(mc);
+  gemv(layout::col_major, mc, nc, A.data(), lda, x.data(), yc1.data(), 1);
+  gemv(layout::col_major, mc, nc, A.data(), lda, x.data(), yc3.data(), 3);
+  REQUIRE(yc1 == yc3);
+  std::vector<double> row(nc);
+  for (size_t i = 0; i < mc; i++) {
+    for (size_t j = 0; j < nc; j++) row[j] = A[j * lda + i];
+    REQUIRE(std::fabs(yc1[i] - exact_dot(row.data(), x.data(), nc)) <=
+            1e-15 * std::fabs(yc1[i]));
+  }
+}
+
+TEST_CASE("Gemv Tests float") {
+  std::vector<float> A{1e8f, 1.0f, -1e8f, 2.0f, 2.0f, 2.0f};
+  std::vector<float> x{1.0f, 1.0f, 1.0f};
+  std::vector<float> y(2);
+  gemv(layout::row_major, 2, 3, A.data(), 3, x.data(), y.data());
+  REQUIRE(y[0] == 1.0f);
+  REQUIRE(y[1] == 6.0f);
+}
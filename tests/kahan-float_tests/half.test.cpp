@@ -0,0 +1,106 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/half.hpp>  // 'src' included
+#include <kahan-float/kahan.hpp>
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Half Tests conversions") {
+  REQUIRE(to_float16(1.0f).bits == 0x3c00);
+  REQUIRE(to_float16(-2.0f).bits == 0xc000);
+  REQUIRE(to_float16(65504.0f).bits == 0x7bff);  // max
+  REQUIRE(to_float16(65520.0f).bits == 0x7c00);  // rounds to inf
+  REQUIRE(to_float16(std::ldexp(1.0f, -24)).bits == 0x0001);  // subnormal
+  REQUIRE(to_float16(std::ldexp(1.0f, -25)).bits == 0x0000);  // tie to even
+  REQUIRE(to_float16(1.0f + std::ldexp(1.0f, -11)).bits == 0x3c00);  // tie
+  REQUIRE(to_float16(1.0f + std::ldexp(3.0f, -11)).bits == 0x3c02);  // tie
+  REQUIRE(std::isnan(float(to_float16(std::nanf("")))));
+  REQUIRE(to_bfloat16(1.0f).bits == 0x3f80);
+  REQUIRE(to_bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3f80);  // tie
+  REQUIRE(std::isnan(float(to_bfloat16(std::nanf("")))));
+
+  // all 16-bit values: widening is exact, and rounding back gives the same
+  int wrong = 0;
+  for (std::uint32_t b = 0; b < 0x10000u; b++) {
+    float16 h;
+    h.bits = std::uint16_t(b);
+    float f = h;
+    // F16C and portable
+    if (detail::float_to_bits(f) !=
+        detail::float_to_bits(detail::half_to_float(h.bits)))
+      wrong++;
+    if (!std::isnan(f) && to_float16(f).bits != h.bits) wrong++;
+    bfloat16 g;
+    g.bits = std::uint16_t(b);
+    float fg = g;
+    if (!std::isnan(fg) && to_bfloat16(fg).bits != g.bits) wrong++;
+  }
+  REQUIRE(wrong == 0);
+  // rounding matches nearest in float (random floats in range)
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<float> runif(-70000.0f, 70000.0f);
+  for (int i = 0; i < 10000; i++) {
+    float f = runif(engine) * std::ldexp(1.0f, -(i % 40));
+    float r = to_float16(f);
+    float16 up, down;
+    up.bits = to_float16(f).bits + 1;  // neighbour away from zero
+    down.bits = to_float16(f).bits - 1;
+    if (std::isinf(r) || r == 0) continue;
+    if (std::fabs(double(r) - f) > std::fabs(double(float(up)) - f)) wrong++;
+    if (std::fabs(double(r) - f) > std::fabs(double(float(down)) - f)) wrong++;
+  }
+  REQUIRE(wrong == 0);
+}
+
+TEST_CASE("Half Tests bulk sums") {
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<float> runif(-1.0f, 1.0f);
+  const size_t n = 100003;  // not a multiple of blocks
+  std::vector<float16> h(n);
+  std::vector<bfloat16> b(n);
+  std::vector<float> hf(n), bf(n);
+  sfloat64 hexact, bexact;
+  for (size_t i = 0; i < n; i++) {
+    float v = runif(engine) * ((i % 7 == 0) ? 1000.0f : 1.0f);
+    h[i] = to_float16(v);
+    b[i] = to_bfloat16(v);
+    hf[i] = h[i];
+    bf[i] = b[i];
+    hexact += double(hf[i]);
+    bexact += double(bf[i]);
+  }
+  // same lanes as over the widened copy
+  REQUIRE(bulk_sum<float>(h.data(), n) == bulk_sum<float>(hf.data(), n));
+  REQUIRE(bulk_sum<float>(b.data(), n) == bulk_sum<float>(bf.data(), n));
+  // compensated float is as accurate as float can be
+  float hs = bulk_sum<float>(h.data(), n).getValue();
+  float bs = bulk_sum<float>(b.data(), n).getValue();
+  REQUIRE(std::fabs(hs - hexact.getValue()) <=
+          std::ldexp(std::fabs(hexact.getValue()), -23));
+  REQUIRE(std::fabs(bs - bexact.getValue()) <=
+          std::ldexp(std::fabs(bexact.getValue()), -23));
+  // into any accumulator
+  nfloat64 acc;
+  bulk_add(acc, h.data(), n);
+  REQUIRE(std::fabs(acc.getValue() - hexact.getValue()) <=
+          std::ldexp(std::fabs(hexact.getValue()), -23));
+  kfloat32 k = 1.0f;
+  bulk_add(k, b.data(), 0);
+  REQUIRE(k.getValue() == 1.0f);
+  // element by element (implicit conversion)
+  kfloat32 e;
+  for (size_t i = 0; i < 10; i++) e += h[i];
+  REQUIRE(e.getValue() != 0.0f);
+}
@@ -0,0 +1,68 @@
+#include <cmath>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/horner.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// coefficients of (x - 2)^n, increasing degree (exact in double for n < 20)
+static std::vector<double> binomial_poly(int n) {
+  std::vector<double> a(n + 1);
+  double binom = 1;
+  for (int k = 0; k <= n; k++) {
+    a[k] = binom * ::pow(-2.0, n - k);
+    binom = binom * (n - k) / (k + 1);
+  }
+  return a;
+}
+
+TEST_CASE("Horner Tests simple polynomial") {
+  std::vector<double> a{1.0, 2.0, 3.0};  // 1 + 2x + 3x^2
+  REQUIRE(horner(a.data(), a.size(), 2.0) == 17.0);
+  REQUIRE(comp_horner(a.data(), a.size(), 2.0) == 17.0);
+  REQUIRE(comp_horner(a.data(), 0, 2.0) == 0.0);
+  REQUIRE(comp_horner(a.data(), 1, 2.0) == 1.0);
+}
+
+TEST_CASE("Horner Tests (x-2)^n near the root") {
+  // evaluation near a multiple root is very ill-conditioned
+  const int n = 9;
+  std::vector<double> a = binomial_poly(n);
+  double worst_plain = 0;
+  double worst_comp = 0;
+  for (int i = 1; i <= 64; i++) {
+    double x = 2.0 + i * ::ldexp(1.0, -10);
+    double exact = ::pow(x - 2.0, n);  // x - 2 is exact here
+    double plain = horner(a.data(), a.size(), x);
+    double comp = comp_horner(a.data(), a.size(), x);
+    worst_plain = std::max(worst_plain, ::fabs(plain - exact) / ::fabs(exact));
+    worst_comp = std::max(worst_comp, ::fabs(comp - exact) / ::fabs(exact));
+  }
+  REQUIRE(worst_plain > 1e-3);   // plain Horner loses most digits
+  REQUIRE(worst_comp < 1e-12);  // compensated keeps almost all of them
+}
+
+TEST_CASE("Horner Tests batch same as scalar") {
+  const int n = 7;
+  std::vector<double> a = binomial_poly(n);
+  std::vector<double> x(37);  // not multiple of lanes
+  for (std::size_t i = 0; i < x.size(); i++) x[i] = 1.9 + 0.005 * i;
+  std::vector<double> out(x.size());
+  comp_horner(a.data(), a.size(), x.data(), out.data(), x.size());
+  for (std::size_t i = 0; i < x.size(); i++)
+    REQUIRE(out[i] == comp_horner(a.data(), a.size(), x[i]));
+
+  std::vector<float> af{0.5f, -1.5f, 1.0f};
+  std::vector<float> xf{0.25f, 0.5f, 1.0f};
+  std::vector<float> outf(xf.size());
+  comp_horner(af.data(), af.size(), xf.data(), outf.data(), xf.size());
+  REQUIRE(outf[1] == 0.0f);  // root of 0.5 - 1.5x + x^2
+  REQUIRE(outf[2] == 0.0f);
+}
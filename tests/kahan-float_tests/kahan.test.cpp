@@ -354,3 +354,79 @@ TEST_CASE("Kahan Tests inf nan neumaier") {
 
   REQUIRE(std::isnan((double)kff3));
 }
+
+TEST_CASE("Kahan Tests branchless neumaier [1,10^100, 1, -10^100]") {
+  nbfloat64 nffsum = 0;
+  REQUIRE(nffsum == 0);  // starts empty
+  nffsum += 1;
+  nffsum += ::pow(10, 100);
+  nffsum += 1;
+  nffsum += -::pow(10, 100);
+  REQUIRE(nffsum == 2);  // expected 2.0, same as nfloat64
+}
+
+TEST_CASE("Kahan Tests branchless neumaier same as neumaier") {
+  nfloat64 n = 0;
+  nbfloat64 nb = 0;
+  for (int i = 0; i < 1000; i++) {
+    double x = (i % 3 ? -1.0 : 1.0) * ::pow(10, (i * 7) % 31 - 15);
+    n += x;
+    nb += x;
+  }
+  REQUIRE((double)nb == (double)n);
+  nfloat64 promoted = nb;  // policies may be converted
+  REQUIRE(promoted == (double)n);
+}
+
+TEST_CASE("Kahan Tests inf nan branchless neumaier") {
+  nbfloat64 kff1 = std::numeric_limits<double>::infinity();
+  kff1 += 1;
+  REQUIRE(kff1 == std::numeric_limits<double>::infinity());
+  kff1 -= 1;
+  REQUIRE(kff1 == std::numeric_limits<double>::infinity());
+  nbfloat64 kff2 = 1 / 0.0;
+  nbfloat64 kff3 = kff1 - kff2;
+
+  REQUIRE(std::isnan((double)kff3));
+}
+
+TEST_CASE("Kahan Tests accumulator + accumulator keeps correction") {
+  kfloat64 ka;
+  nfloat64 na;
+  ka += 1.0;
+  na += 1.0;
+  for (int i = 0; i < 10; i++) {
+    ka += 1e-17;
+    na += 1e-17;
+  }
+  REQUIRE(ka.getC() != 0.0);
+  REQUIRE(na.getC() != 0.0);
+  // same as adding value and correction one by one
+  kfloat64 kb(2.0);
+  kfloat64 kr(2.0);
+  kb += ka;
+  kr += ka.getValue();
+  kr += -ka.getC();  // kahan 'c' is minus the lost digits
+  REQUIRE(kb == kr);
+  REQUIRE(kb.getC() != 0.0);
+  REQUIRE((kfloat64(2.0) + ka) == kb);
+  nfloat64 nb(2.0);
+  nfloat64 nr(2.0);
+  nb += na;
+  nr += na.getRawValue();
+  nr += na.getC();
+  REQUIRE(nb.getRawValue() == nr.getRawValue());
+  REQUIRE(nb.getC() == nr.getC());
+  REQUIRE((nfloat64(2.0) + na).getC() == nr.getC());
+  // self
+  nfloat64 ns(na);
+  ns += na.getRawValue();
+  ns += na.getC();
+  na += na;
+  REQUIRE(na.getRawValue() == ns.getRawValue());
+  REQUIRE(na.getC() == ns.getC());
+  // difference
+  nb -= nfloat64(1.0, nr.getC());
+  REQUIRE(nb.getRawValue() == 2.0);
+  REQUIRE(nb.getC() == 0.0);
+}
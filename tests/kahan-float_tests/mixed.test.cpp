@@ -0,0 +1,83 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/mixed.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Mixed Tests float inputs into double") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<float> runif(-1.0f, 1.0f);
+  std::vector<float> x(100003);
+  std::vector<double> xd(x.size());
+  sfloat64 exact;
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = runif(engine);
+    xd[i] = x[i];
+    exact += xd[i];
+  }
+  // same sum as over a widened copy
+  REQUIRE(bulk_sum<double>(x.data(), x.size()) ==
+          bulk_sum<double>(xd.data(), xd.size()));
+  REQUIRE(bulk_sum<double>(x.data(), x.size()).getValue() == exact.getValue());
+  nfloat64 acc;
+  bulk_add(acc, x.data(), x.size());
+  REQUIRE(acc.getValue() == exact.getValue());
+}
+
+TEST_CASE("Mixed Tests double inputs into float") {
+  // 0.1 is not a float: casting loses ~1.5e-9 on each element
+  const size_t n = 100000;
+  std::vector<double> x(n, 0.1);
+  sfloat64 exact;
+  for (double v : x) exact += v;
+
+  double lost = 0;
+  nbfloat32 r = bulk_sum_narrow(x.data(), n, lost);
+  double pair = double(r.getRawValue()) + double(r.getC());
+  // float pair: error about n u^2 sum|x| (u = 2^-24)
+  REQUIRE(std::fabs(pair - exact.getValue()) <= 5e-5);
+  REQUIRE(std::fabs(lost) <= 1e-9);
+  REQUIRE(r.getValue() == float(exact.getValue()));
+  // plain cast: float pair is off by n * 1.5e-9
+  nbfloat32 cast = bulk_sum<float>(x.data(), n);
+  double cpair = double(cast.getRawValue()) + double(cast.getC());
+  REQUIRE(std::fabs(cpair - exact.getValue()) > 1e-4);
+
+  // into any accumulator, in parts
+  kfloat32 k;
+  double klost = 0;
+  bulk_add_narrow(k, x.data(), n / 2, klost);
+  bulk_add_narrow(k, x.data() + n / 2, n - n / 2, klost);
+  REQUIRE(std::fabs(k.getValue() - exact.getValue()) <=
+          std::ldexp(exact.getValue(), -23));
+
+  // random full-precision doubles, with cancellation
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> y(10007);
+  sfloat64 yexact;
+  for (size_t i = 0; i < y.size(); i++) {
+    y[i] = runif(engine) * ((i % 2) ? 1e3 : 1.0);
+    yexact += y[i];
+  }
+  nbfloat32 ry = bulk_sum_narrow(y.data(), y.size(), lost);
+  REQUIRE(std::fabs(ry.getValue() - yexact.getValue()) <=
+          std::ldexp(std::fabs(yexact.getValue()), -23));
+
+  // overflow of float is reported
+  std::vector<double> big{1e300, 1.0};
+  bulk_sum_narrow(big.data(), big.size(), lost);
+  REQUIRE(!std::isfinite(lost));
+}
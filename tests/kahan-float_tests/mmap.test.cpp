@@ -0,0 +1,67 @@
+#include <cerrno>
+#include <cstdio>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/mmap.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// writes raw binary file of 'v' (native byte order)
+template <class X>
+static bool write_raw(const char* path, const std::vector<X>& v) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  size_t w = fwrite(v.data(), sizeof(X), v.size(), f);
+  fclose(f);
+  return w == v.size();
+}
+
+TEST_CASE("Mmap Tests sum double file") {
+  const char* path = "kahan_mmap_test_double.bin";
+  std::vector<double> v{1, 1e100, 1, -1e100};
+  for (int i = 0; i < 100; i++) v.push_back(0.1);
+  REQUIRE(write_raw(path, v));
+
+  mapped_file f(path);
+  REQUIRE(f.is_open());
+  REQUIRE(f.size() == v.size() * sizeof(double));
+  f.close();
+  REQUIRE(!f.is_open());
+
+  nbfloat64 sum;
+  REQUIRE(sum_file<double, double>(path, sum));
+  REQUIRE(sum.getValue() == 12.0);
+  remove(path);
+}
+
+TEST_CASE("Mmap Tests sum float file") {
+  const char* path = "kahan_mmap_test_float.bin";
+  std::vector<float> v(1000, 0.1f);
+  REQUIRE(write_raw(path, v));
+  nbfloat64 sum;
+  REQUIRE(sum_file<double, float>(path, sum, 2));
+  REQUIRE(sum.getValue() == 1000 * (double)0.1f);
+  // same file, wrong element size
+  std::vector<char> c(7, 0);
+  REQUIRE(write_raw(path, c));
+  REQUIRE(!sum_file<double, float>(path, sum));
+  REQUIRE(errno == EINVAL);
+  remove(path);
+}
+
+TEST_CASE("Mmap Tests empty and missing file") {
+  const char* path = "kahan_mmap_test_empty.bin";
+  REQUIRE(write_raw(path, std::vector<double>()));
+  nbfloat64 sum = 1.0;
+  REQUIRE(sum_file<double, double>(path, sum));
+  REQUIRE(sum.getValue() == 0.0);
+  remove(path);
+  REQUIRE(!sum_file<double, double>("kahan_mmap_test_missing.bin", sum));
+}
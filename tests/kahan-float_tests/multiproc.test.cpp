@@ -0,0 +1,122 @@
+#include <unistd.h>  // _exit
+
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/multiproc.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Merge Tests keep pending corrections") {
+  // raw value of each partial is 0 (1.0 is in its correction)
+  nfloat64 a;
+  a += 1e100;
+  a += 1.0;
+  a += -1e100;
+  nfloat64 b = a;
+  REQUIRE(merge(b, a).getValue() == 2.0);
+
+  nbfloat64 la;
+  la += 1e100;
+  la += 1.0;
+  la += -1e100;
+  nbfloat64 lb = la;
+  REQUIRE(merge(lb, la).getValue() == 2.0);
+
+  kfloat64 ka;
+  kfloat64 kb;
+  for (int i = 0; i < 10; i++) {
+    ka += 0.1;
+    kb += 0.1;
+  }
+  kfloat64 k;
+  for (int i = 0; i < 20; i++) k += 0.1;
+  REQUIRE(merge(ka, kb).getValue() == k.getValue());
+}
+
+TEST_CASE("Merge Tests shewchuk is exact") {
+  sfloat64 a;
+  a += 1e100;
+  a += 1.0;
+  sfloat64 b;
+  b += -1e100;
+  b += 1e-100;
+  REQUIRE(merge(a, b).getValue() == 1.0);
+  sfloat64 c;
+  c += -1.0;
+  REQUIRE(merge(a, c).getValue() == 1e-100);
+
+  sfloat64 inf;
+  inf += std::numeric_limits<double>::infinity();
+  REQUIRE(std::isinf(merge(c, inf).getValue()));
+  sfloat64 ninf;
+  ninf += -std::numeric_limits<double>::infinity();
+  REQUIRE(std::isnan(merge(c, ninf).getValue()));
+}
+
+TEST_CASE("Multiproc Tests tree reduction is reproducible") {
+  std::vector<double> v;
+  for (int i = 0; i < 100000; i++) v.push_back(0.1);
+  double exact = fsum(v.data(), v.size());
+
+  for (unsigned w = 1; w <= 5; w++) {
+    nbfloat64 r1, r2;
+    REQUIRE(process_sum<double>(v.data(), v.size(), r1, w));
+    REQUIRE(process_sum<double>(v.data(), v.size(), r2, w));
+    REQUIRE(r1.getValue() == r2.getValue());
+    REQUIRE(std::fabs(r1.getValue() - exact) <= 1e-15 * exact);
+  }
+}
+
+TEST_CASE("Multiproc Tests generic work") {
+  // each rank adds 'rank + 0.5', merged exactly
+  sfloat64 r;
+  REQUIRE(process_reduce(
+      7, [](unsigned rank, sfloat64& acc) { acc += rank + 0.5; }, r));
+  REQUIRE(r.getValue() == 24.5);
+}
+
+TEST_CASE("Multiproc Tests failed worker") {
+  nfloat64 r(7.0);
+  errno = 0;
+  REQUIRE(!process_reduce(
+      4,
+      [](unsigned rank, nfloat64& acc) {
+        if (rank == 1) ::_exit(3);
+        acc += 1.0;
+      },
+      r));
+  REQUIRE(errno == ECHILD);
+  REQUIRE(r.getValue() == 7.0);
+}
+
+TEST_CASE("Multiproc Tests exact cancellation") {
+  sfloat64 r;
+  REQUIRE(process_reduce(
+      2, [](unsigned rank, sfloat64& acc) { acc += rank ? -1.0 : 1.0; }, r));
+  REQUIRE(r.getValue() == 0.0);
+}
+
+TEST_CASE("Multiproc Tests record does not fit") {
+  auto work = [](unsigned, sfloat64& acc) {
+    acc += 1e100;
+    acc += 1.0;
+    acc += 1e-100;  // 3 partials: 48 bytes
+  };
+  sfloat64 r(7.0);
+  errno = 0;
+  REQUIRE(!process_reduce(2, work, r, 40));
+  REQUIRE(errno == EMSGSIZE);
+  REQUIRE(r.getValue() == 7.0);
+  REQUIRE(process_reduce(2, work, r, 48));
+  REQUIRE(r.getValue() == 2e100);
+}
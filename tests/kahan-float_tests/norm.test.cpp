@@ -0,0 +1,90 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/norm.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// sqrt of correctly rounded sum of squares (values in safe range)
+static double ref_norm(const std::vector<double>& x) {
+  sfloat64 s;
+  for (double v : x) {
+    double h, r;
+    eft::two_prod(v, v, h, r);
+    s += h;
+    s += r;
+  }
+  return std::sqrt(s.getValue());
+}
+
+// distance in ulps of 'ref'
+static double ulps(double v, double ref) {
+  return std::fabs(v - ref) / (std::ldexp(1.0, std::ilogb(ref) - 52));
+}
+
+TEST_CASE("Norm Tests simple values") {
+  std::vector<double> x{3.0, 4.0};
+  REQUIRE(norm2(x.data(), 2) == 5.0);
+  REQUIRE(sumsq(x.data(), 2) == 25.0);
+  REQUIRE(comp_hypot(3.0, 4.0) == 5.0);
+  REQUIRE(comp_hypot(3.0f, 4.0f) == 5.0f);
+  REQUIRE(norm2(x.data(), 0) == 0.0);
+  std::vector<double> z(10, 0.0);
+  REQUIRE(norm2(z.data(), z.size()) == 0.0);
+  // error of each square is kept: (1 + 2^-30)^2 = 1 + 2^-29 + 2^-60
+  std::vector<double> e{1.0 + std::ldexp(1.0, -30)};
+  REQUIRE(sumsq(e.data(), 1) == 1.0 + std::ldexp(1.0, -29));
+}
+
+TEST_CASE("Norm Tests no overflow or underflow") {
+  REQUIRE(comp_hypot(3e300, 4e300) == 5e300);
+  REQUIRE(comp_hypot(3e-300, 4e-300) == 5e-300);
+  REQUIRE(comp_hypot(3e-320, 4e-320) == 5e-320);  // subnormal
+  REQUIRE(comp_hypot(3e30f, 4e30f) == 5e30f);
+  REQUIRE(comp_hypot(3e-30f, 4e-30f) == 5e-30f);
+  // mixed magnitudes: big dominates, small is negligible
+  std::vector<double> x{3e300, 1.0, 4e300, 1e-300};
+  REQUIRE(norm2(x.data(), x.size()) == 5e300);
+  // small and medium
+  std::vector<double> y{3e-300, 3.0, 4.0, 4e-300};
+  REQUIRE(norm2(y.data(), y.size()) == 5.0);
+  std::vector<double> w(1000, 1e-300);
+  REQUIRE(ulps(norm2(w.data(), w.size()), std::sqrt(1000.0) * 1e-300) <= 1);
+}
+
+TEST_CASE("Norm Tests special values") {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> x{1.0, -inf, 2.0};
+  REQUIRE(norm2(x.data(), x.size()) == inf);
+  std::vector<double> y{1.0, nan, 2.0};
+  REQUIRE(std::isnan(norm2(y.data(), y.size())));
+  std::vector<double> z{1e300, nan, 2.0};
+  REQUIRE(std::isnan(norm2(z.data(), z.size())));
+}
+
+TEST_CASE("Norm Tests accuracy") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  for (int t = 0; t < 20; t++) {
+    std::vector<double> x(1000 + 997 * t);
+    for (double& v : x) v = runif(engine);
+    double ref = ref_norm(x);
+    REQUIRE(ulps(norm2(x.data(), x.size()), ref) <= 1);
+    // same vector scaled into Blue's ranges (exact scaling)
+    for (double& v : x) v = std::ldexp(v, 700);
+    REQUIRE(ulps(norm2(x.data(), x.size()), std::ldexp(ref, 700)) <= 1);
+    for (double& v : x) v = std::ldexp(v, -1300);
+    REQUIRE(ulps(norm2(x.data(), x.size()), std::ldexp(ref, -600)) <= 1);
+  }
+}
@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>  // move
+#include <vector>
+
+#include <sys/mman.h>  // mincore
+#include <sys/stat.h>  // mkdir
+#include <unistd.h>    // rmdir, unlink, sysconf
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/numa.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Numa Tests topology") {
+  std::vector<unsigned> cpus;
+  REQUIRE(detail::parse_cpulist("0-3,8,10-11\n", cpus));
+  REQUIRE(cpus == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11});
+  cpus.clear();
+  REQUIRE(!detail::parse_cpulist("3-1", cpus));
+  REQUIRE(!detail::parse_cpulist("x", cpus));
+
+  // fake sysfs tree: node1 before node0 on disk, node2 has no cpus
+  char root[] = "/tmp/kahan_numa_XXXXXX";
+  REQUIRE(::mkdtemp(root) != nullptr);
+  const char* lists[] = {"0-1\n", "2,3\n", "\n"};
+  for (int k = 2; k >= 0; k--) {
+    std::string dir = std::string(root) + "/node" + std::to_string(k);
+    REQUIRE(::mkdir(dir.c_str(), 0700) == 0);
+    std::FILE* f = std::fopen((dir + "/cpulist").c_str(), "w");
+    REQUIRE(f != nullptr);
+    std::fputs(lists[k], f);
+    std::fclose(f);
+  }
+  std::vector<numa_node> nodes = numa_nodes(root);
+  REQUIRE(nodes.size() == 2);
+  REQUIRE(nodes[0].id == 0);
+  REQUIRE(nodes[0].cpus == std::vector<unsigned>{0, 1});
+  REQUIRE(nodes[1].cpus == std::vector<unsigned>{2, 3});
+  for (int k = 0; k < 3; k++) {
+    std::string dir = std::string(root) + "/node" + std::to_string(k);
+    ::unlink((dir + "/cpulist").c_str());
+    ::rmdir(dir.c_str());
+  }
+  ::rmdir(root);
+
+  // no topology: one node with all cpus
+  std::vector<numa_node> none = numa_nodes("/nonexistent/kahan");
+  REQUIRE(none.size() == 1);
+  REQUIRE(none[0].cpus.size() == default_threads());
+  REQUIRE(!numa_nodes().empty());
+}
+
+TEST_CASE("Numa Tests first touch and sum") {
+  // two nodes of the real cpus (binding unknown cpus is not an error)
+  std::vector<numa_node> nodes(2);
+  nodes[0].id = 0;
+  nodes[0].cpus = {0};
+  nodes[1].id = 1;
+  nodes[1].cpus = {0, 1};
+  const std::size_t n = 300007;
+  numa_buffer<double> x(n);
+  REQUIRE(x.size() == n);
+  // no page is resident (placed) before first touch
+  const std::size_t page = std::size_t(::sysconf(_SC_PAGESIZE));
+  const std::size_t pages = (n * sizeof(double) + page - 1) / page;
+  std::vector<unsigned char> resident(pages);
+  REQUIRE(::mincore(x.data(), n * sizeof(double), resident.data()) == 0);
+  int placed = 0;
+  for (unsigned char v : resident) placed += v & 1;
+  REQUIRE(placed == 0);
+  std::vector<int> touched(n, 0);
+  numa_for(n, nodes, 2, [&](const numa_range& r) {
+    std::default_random_engine engine(unsigned(r.index));
+    std::uniform_real_distribution<double> runif(-1, 1);
+    for (std::size_t i = r.begin; i < r.end; i++) {
+      x[i] = runif(engine) * ((i % 7 == 0) ? 1e12 : 1.0);
+      touched[i]++;
+    }
+  });
+  int wrong = 0;
+  for (std::size_t i = 0; i < n; i++)
+    if (touched[i] != 1) wrong++;
+  REQUIRE(wrong == 0);
+  REQUIRE(::mincore(x.data(), n * sizeof(double), resident.data()) == 0);
+  placed = 0;
+  for (unsigned char v : resident) placed += v & 1;
+  REQUIRE(placed == int(pages));
+  // node 1 has twice the cpus: twice the elements
+  std::vector<numa_range> split = detail::numa_split(n, nodes, 2);
+  REQUIRE(split.size() == 4);
+  REQUIRE(split[2].begin == n / 3);
+  REQUIRE(split[3].end == n);
+
+  double exact = fsum(x.data(), x.size());
+  double r = numa_sum<double>(x.data(), n, nodes, 2).getValue();
+  REQUIRE(r == exact);
+  REQUIRE(numa_sum<double>(x.data(), n, nodes, 2).getValue() == r);
+  REQUIRE(numa_sum<double>(x.data(), n).getValue() == exact);
+  REQUIRE(numa_sum<double>(x.data(), 10, nodes).getValue() ==
+          bulk_sum<double>(x.data(), 10).getValue());
+
+  // moves keep the mapping
+  numa_buffer<double> y(std::move(x));
+  REQUIRE(x.data() == nullptr);
+  REQUIRE(y.size() == n);
+  REQUIRE(fsum(y.data(), y.size()) == exact);
+  numa_buffer<double> empty(0);
+  REQUIRE(empty.size() == 0);
+}
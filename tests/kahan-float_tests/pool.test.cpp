@@ -0,0 +1,106 @@
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/pool.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Pool Tests run") {
+  for (unsigned threads = 1; threads <= 4; threads++) {
+    work_pool pool(threads);
+    REQUIRE(pool.size() == threads);
+    // each task exactly once, on every call
+    for (std::size_t n : {0, 1, 3, 1000}) {
+      std::vector<std::atomic<int>> hits(n);
+      for (auto& h : hits) h = 0;
+      pool.run(n, [&hits](std::size_t id) { hits[id]++; });
+      int wrong = 0;
+      for (auto& h : hits)
+        if (h != 1) wrong++;
+      REQUIRE(wrong == 0);
+    }
+  }
+  // skewed tasks: the first ones are heavy, so other threads steal them
+  work_pool pool(4);
+  std::atomic<long> work{0};
+  pool.run(64, [&work](std::size_t id) {
+    long k = (id < 8) ? 200000 : 10;
+    for (long i = 0; i < k; i++) work++;
+  });
+  REQUIRE(work == 8 * 200000 + 56 * 10);
+}
+
+TEST_CASE("Pool Tests deterministic reductions") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> x(300007);
+  for (size_t i = 0; i < x.size(); i++)
+    x[i] = runif(engine) * ((i % 5 == 0) ? 1e10 : 1.0);
+  double exact = fsum(x.data(), x.size());
+
+  work_pool p1(1), p4(4);
+  double r1 = pool_sum<double>(p1, x.data(), x.size(), 1000).getValue();
+  double r4 = pool_sum<double>(p4, x.data(), x.size(), 1000).getValue();
+  REQUIRE(r1 == r4);  // same tasks, whatever the threads
+  REQUIRE(r1 == exact);
+  for (int r = 0; r < 5; r++)
+    REQUIRE(pool_sum<double>(p4, x.data(), x.size(), 1000).getValue() == r4);
+
+  // per-task partials of any accumulator, merged in id order
+  auto f = [&x](std::size_t id, kfloat64& part) {
+    for (std::size_t i = id; i < x.size(); i += 97) part += x[i];
+  };
+  kfloat64 k1 = pool_reduce<kfloat64>(p1, 97, f);
+  kfloat64 k4 = pool_reduce<kfloat64>(p4, 97, f);
+  REQUIRE(k1 == k4);
+  REQUIRE(std::fabs(k4.getValue() - exact) <=
+          std::ldexp(std::fabs(exact), -50));
+}
+
+TEST_CASE("Pool Tests ragged rows") {
+  // heavy hitter: one row holds most elements
+  std::vector<std::vector<double>> data(50);
+  data[7].assign(200003, 0.1);
+  for (size_t i = 0; i < data.size(); i++)
+    if (i != 7) data[i].assign(i * 3, 1e-3 * i);
+  data[3].clear();
+  std::vector<const double*> rows;
+  std::vector<std::size_t> len;
+  for (auto& r : data) {
+    rows.push_back(r.data());
+    len.push_back(r.size());
+  }
+  work_pool pool(3);
+  std::vector<double> row_sums(data.size());
+  double total = ragged_sum<double>(pool, rows.data(), len.data(),
+                                    data.size(), row_sums.data(), 1000)
+                     .getValue();
+  sfloat64 exact;
+  int wrong = 0;
+  for (size_t i = 0; i < data.size(); i++) {
+    sfloat64 e;
+    for (double v : data[i]) {
+      e += v;
+      exact += v;
+    }
+    if (row_sums[i] != e.getValue()) wrong++;
+  }
+  REQUIRE(wrong == 0);
+  REQUIRE(total == exact.getValue());
+  // same result on one thread
+  work_pool one(1);
+  REQUIRE(ragged_sum<double>(one, rows.data(), len.data(), data.size(),
+                             nullptr, 1000)
+              .getValue() == total);
+}
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <list>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/neumaier.hpp>
+#include <kahan-float/ranges.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+#if KAHAN_HAS_RANGES
+
+TEST_CASE("Ranges Tests sum and fold") {
+  std::vector<double> x{1e16, 1.0, -1e16, 1.0};
+  REQUIRE(kahan::ranges::sum(x).getValue() == 2.0);
+  REQUIRE(kahan::ranges::sum<kfloat64>(x).getValue() == 2.0);
+  // non-contiguous
+  std::list<double> l(x.begin(), x.end());
+  REQUIRE(kahan::ranges::sum(l).getValue() == 2.0);
+  // lazy (generated) range, no vector
+  auto tenth = std::views::iota(0, 100003) |
+               std::views::transform([](int) { return 0.1; });
+  sfloat64 exact;
+  for (int i = 0; i < 100003; i++) exact += 0.1;
+  REQUIRE(kahan::ranges::sum(tenth).getValue() == exact.getValue());
+  // same lanes as the bulk kernel
+  std::vector<double> v(tenth.begin(), tenth.end());
+  REQUIRE(kahan::ranges::sum(tenth) == bulk_sum<double>(v.data(), v.size()));
+  // projection
+  struct account {
+    int id;
+    double balance;
+  };
+  std::vector<account> a{{1, 1e16}, {2, 1.0}, {3, -1e16}};
+  REQUIRE(kahan::ranges::sum(a, &account::balance).getValue() == 1.0);
+  // fold into any accumulator
+  kfloat64 k = kahan::ranges::fold(x, kfloat64(10.0));
+  REQUIRE(k.getValue() == 12.0);
+  nfloat64 e = kahan::ranges::fold(std::views::empty<double>, nfloat64(3.0));
+  REQUIRE(e.getValue() == 3.0);
+  // partials are merged (both corrections kept)
+  std::vector<nfloat64> parts{nfloat64(1e16, 1.0), nfloat64(-1e16, 1.0)};
+  REQUIRE(kahan::ranges::sum(parts).getValue() == 2.0);
+  // float lanes
+  std::vector<float> f(1000, 0.1f);
+  REQUIRE(kahan::ranges::sum<nfloat32>(f | std::views::reverse).getValue() ==
+          float(1000 * double(0.1f)));
+}
+
+TEST_CASE("Ranges Tests partial sum view") {
+  std::vector<double> x{1e16, 1.0, -1e16, 1.0};
+  std::vector<double> r;
+  for (double s : x | kahan::views::kahan_partial_sum) r.push_back(s);
+  REQUIRE(r == std::vector<double>{1e16, 1e16 + 1.0, 1.0, 2.0});
+  auto p = kahan::views::kahan_partial_sum(x);
+  REQUIRE(p.size() == 4);
+  static_assert(std::ranges::forward_range<decltype(p)>);
+  // composes with standard views (lazy)
+  auto last = x | kahan::views::kahan_partial_sum | std::views::drop(3);
+  REQUIRE(*last.begin() == 2.0);
+  auto gen = std::views::iota(1, 11) |
+             std::views::transform([](int i) { return 0.1 * i; }) |
+             kahan::views::kahan_partial_sum_as<kfloat64>;
+  double prev = 0;
+  int n = 0;
+  for (double s : gen) {
+    REQUIRE(s > prev);
+    prev = s;
+    n++;
+  }
+  REQUIRE(n == 10);
+  REQUIRE(std::fabs(prev - 5.5) <= 1e-15);
+}
+
+TEST_CASE("Ranges Tests partial sum view reads each element once") {
+  int calls = 0;
+  auto counted = std::views::iota(1, 101) |
+                 std::views::transform([&calls](int i) {
+                   calls++;
+                   return 0.1 * i;
+                 }) |
+                 kahan::views::kahan_partial_sum;
+  double last = 0;
+  for (auto it = counted.begin(); it != counted.end(); ++it) {
+    REQUIRE(*it == *it);  // dereferenced twice
+    last = *it;
+  }
+  REQUIRE(calls == 100);
+  REQUIRE(std::fabs(last - 505.0) <= 1e-12);
+  // single-pass input range
+  std::istringstream in("1e16 1 -1e16 1");
+  std::vector<double> r;
+  for (double s : std::views::istream<double>(in) |
+                      kahan::views::kahan_partial_sum)
+    r.push_back(s);
+  REQUIRE(r == std::vector<double>{1e16, 1e16 + 1.0, 1.0, 2.0});
+}
+
+#endif  // KAHAN_HAS_RANGES
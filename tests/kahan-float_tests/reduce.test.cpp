@@ -0,0 +1,163 @@
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/merge.hpp>
+#include <kahan-float/neumaier.hpp>
+#include <kahan-float/reduce.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Reduce Tests compensated_plus") {
+  compensated_plus<nfloat64> plus;
+  // element + element is compensated
+  nfloat64 a = plus(1e16, 1.0);
+  REQUIRE(a.getRawValue() == 1e16);
+  REQUIRE(a.getC() == 1.0);
+  REQUIRE(plus(a, -1e16).getValue() == 1.0);
+  REQUIRE(plus(-1e16, a).getValue() == 1.0);
+  // partial + partial keeps both corrections (as '+' does)
+  nfloat64 b = plus(-1e16, 1.0);
+  REQUIRE(plus(a, b).getValue() == 2.0);
+  REQUIRE((a + b).getValue() == 2.0);
+  // kahan partials
+  compensated_plus<kfloat64> kplus;
+  kfloat64 k = kplus(1.0, 1e-16);
+  REQUIRE(k.getC() != 0.0);
+  REQUIRE(kplus(k, kfloat64(-1.0)).getValue() != 0.0);
+  // serial fold (any standard)
+  std::vector<double> x{1e16, 1.0, -1e16, 1.0};
+  REQUIRE(std::accumulate(x.begin(), x.end(), nfloat64(), plus).getValue() ==
+          2.0);
+}
+
+#if KAHAN_HAS_EXECUTION
+
+TEST_CASE("Reduce Tests parallel policies") {
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> x(1 << 18);
+  sfloat64 exact;
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = runif(engine) * ((i % 3 == 0) ? 1e12 : 1.0);
+    exact += x[i];
+  }
+  const double tol = std::ldexp(std::fabs(exact.getValue()), -52);
+  // any split keeps the serial accuracy
+  nfloat64 r = kahan::reduce<nfloat64>(std::execution::par_unseq, x.begin(),
+                                       x.end());
+  REQUIRE(std::fabs(r.getValue() - exact.getValue()) <= tol);
+  nfloat64 p = kahan::reduce<nfloat64>(std::execution::par, x.begin(), x.end());
+  REQUIRE(std::fabs(p.getValue() - exact.getValue()) <= tol);
+  kfloat64 k = kahan::reduce<kfloat64>(std::execution::par_unseq, x.begin(),
+                                       x.end());
+  REQUIRE(std::fabs(k.getValue() - exact.getValue()) <= tol);
+  nfloat64 s = kahan::reduce<nfloat64>(x.begin(), x.end());
+  REQUIRE(std::fabs(s.getValue() - exact.getValue()) <= tol);
+  // initial value
+  nfloat64 i = kahan::reduce(std::execution::seq, x.begin(), x.begin() + 2,
+                             nfloat64(1.0));
+  REQUIRE(i.getValue() == (1.0 + x[0]) + x[1]);
+  // partials as elements (e.g. per-block accumulators)
+  std::vector<nfloat64> parts(64);
+  for (size_t j = 0; j < x.size(); j++) parts[j % 64] += x[j];
+  nfloat64 q = kahan::reduce<nfloat64>(std::execution::par_unseq,
+                                       parts.begin(), parts.end());
+  REQUIRE(std::fabs(q.getValue() - exact.getValue()) <= tol);
+}
+
+TEST_CASE("Reduce Tests default plus keeps corrections") {
+  // partials whose values cancel: the sum is carried by the corrections
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> x(1 << 12);
+  sfloat64 exact;
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = runif(engine);
+    exact += x[i];
+  }
+  auto part = [&x](size_t i) {
+    return nfloat64((i % 2) ? -1e16 : 1e16, x[i]);
+  };
+  std::vector<nfloat64> parts(x.size());
+  std::vector<kfloat64> kparts(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    parts[i] = part(i);
+    kparts[i] = kfloat64(x[i], -std::ldexp(x[i], -30));  // x * (1 + 2^-30)
+  }
+  // sequential reference: merge in order
+  nfloat64 ref;
+  kfloat64 kref;
+  for (size_t i = 0; i < x.size(); i++) {
+    merge(ref, parts[i]);
+    merge(kref, kparts[i]);
+  }
+  REQUIRE(std::fabs(ref.getValue() - exact.getValue()) <= 1e-12);
+  // kahan: 'c' of the partials adds 2^-30 of the sum (kahan 'c' is minus
+  // the lost digits)
+  const double kexact = exact.getValue() + std::ldexp(exact.getValue(), -30);
+  REQUIRE(std::fabs(kref.getValue() - kref.getC() - kexact) <= 1e-12);
+  // no custom op ('std::plus'): in order, same as the reference
+  nfloat64 s = std::accumulate(parts.begin(), parts.end(), nfloat64());
+  REQUIRE(s.getRawValue() == ref.getRawValue());
+  REQUIRE(s.getC() == ref.getC());
+  kfloat64 ks = std::accumulate(kparts.begin(), kparts.end(), kfloat64());
+  REQUIRE(ks.getC() == kref.getC());
+  REQUIRE(ks == kref);
+  // any order: only correct if both corrections are kept
+  nfloat64 r = std::reduce(parts.begin(), parts.end(), nfloat64());
+  REQUIRE(std::fabs(r.getValue() - exact.getValue()) <= 1e-12);
+  nfloat64 p = std::reduce(std::execution::par, parts.begin(), parts.end(),
+                           nfloat64());
+  REQUIRE(std::fabs(p.getValue() - exact.getValue()) <= 1e-12);
+  kfloat64 kp = std::reduce(std::execution::par_unseq, kparts.begin(),
+                            kparts.end(), kfloat64());
+  REQUIRE(std::fabs(kp.getValue() - kp.getC() - kexact) <= 1e-12);
+  // no custom reduction op, partials from the transform
+  std::vector<size_t> id(x.size());
+  std::iota(id.begin(), id.end(), size_t(0));
+  nfloat64 t = std::transform_reduce(std::execution::par, id.begin(),
+                                     id.end(), nfloat64(), std::plus<>(),
+                                     part);
+  REQUIRE(std::fabs(t.getValue() - exact.getValue()) <= 1e-12);
+  kfloat64 kt = std::transform_reduce(
+      id.begin(), id.end(), kfloat64(), std::plus<>(),
+      [&kparts](size_t i) { return kparts[i]; });
+  REQUIRE(std::fabs(kt.getValue() - kt.getC() - kexact) <= 1e-12);
+}
+
+TEST_CASE("Reduce Tests transform_reduce") {
+  // 0.1 is not a double: squares and products add up rounding
+  std::vector<double> x(100003, 0.1);
+  std::vector<double> y(x.size(), 3.0);
+  sfloat64 sq, dot;
+  for (size_t i = 0; i < x.size(); i++) {
+    sq += x[i] * x[i];
+    dot += x[i] * y[i];
+  }
+  nfloat64 r = kahan::transform_reduce(
+      std::execution::par_unseq, x.begin(), x.end(), nfloat64(),
+      [](double v) { return v * v; });
+  REQUIRE(std::fabs(r.getValue() - sq.getValue()) <=
+          std::ldexp(sq.getValue(), -52));
+  nfloat64 d = kahan::transform_reduce<nfloat64>(std::execution::par_unseq,
+                                                 x.begin(), x.end(), y.begin());
+  REQUIRE(std::fabs(d.getValue() - dot.getValue()) <=
+          std::ldexp(dot.getValue(), -52));
+  kfloat64 s = kahan::transform_reduce(x.begin(), x.end(), kfloat64(),
+                                       [](double v) { return -v; });
+  REQUIRE(std::fabs(s.getValue() + 10000.3) <= 1e-9);
+}
+
+#endif  // KAHAN_HAS_EXECUTION
@@ -0,0 +1,240 @@
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/serialize.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// round trip through a buffer: continuing from the copy must give exactly
+// the same result as continuing from the original
+template <class Acc>
+static void check_round_trip(const Acc& acc) {
+  std::vector<unsigned char> buf(serialized_size(acc));
+  REQUIRE(serialize(acc, buf.data(), buf.size()) == buf.size());
+  Acc copy;
+  REQUIRE(deserialize(buf.data(), buf.size(), copy) == buf.size());
+  REQUIRE(copy.getValue() == acc.getValue());
+  Acc a = acc;
+  for (int i = 0; i < 10; i++) {
+    a += 0.1;
+    copy += 0.1;
+  }
+  REQUIRE(copy.getValue() == a.getValue());
+}
+
+TEST_CASE("Serialize Tests round trip keeps correction") {
+  kfloat64 k;
+  nfloat64 n;
+  nbfloat64 nb;
+  sfloat64 s;
+  kfloat32 kf;
+  nfloat32 nf;
+  for (int i = 0; i < 1000; i++) {
+    k += 0.1;
+    n += 0.1;
+    nb += 0.1;
+    s += 0.1;
+    kf += 0.1f;
+    nf += 0.1f;
+  }
+  REQUIRE(k.getC() != 0);
+  check_round_trip(k);
+  check_round_trip(n);
+  check_round_trip(nb);
+  check_round_trip(s);
+  check_round_trip(kf);
+  check_round_trip(nf);
+}
+
+TEST_CASE("Serialize Tests neumaier correction is not lost") {
+  nfloat64 n;
+  n += 1e100;
+  n += 1.0;
+  n += -1e100;
+  // value alone would restore zero
+  REQUIRE(n.getValue() == 1.0);
+  REQUIRE(n.getRawValue() == 0.0);
+  unsigned char buf[24];
+  REQUIRE(serialize(n, buf, sizeof(buf)) == 24);
+  nfloat64 r;
+  REQUIRE(deserialize(buf, sizeof(buf), r) == 24);
+  REQUIRE(r.getRawValue() == 0.0);
+  REQUIRE(r.getC() == 1.0);
+  REQUIRE(r.getValue() == 1.0);
+  // neumaier records are shared by all neumaier types
+  nbfloat64 nb;
+  REQUIRE(deserialize(buf, sizeof(buf), nb) == 24);
+  REQUIRE(nb.getValue() == 1.0);
+}
+
+TEST_CASE("Serialize Tests fixed byte layout") {
+  kfloat64 k(1.0, 0.5);
+  unsigned char buf[24];
+  REQUIRE(serialize(k, buf, sizeof(buf)) == 24);
+  // header, 1.0 and 0.5 (little-endian)
+  const unsigned char expected[24] = {'K', 'F', 1, 1, 8, 0, 2, 0,
+                                      0, 0, 0, 0, 0, 0, 0xF0, 0x3F,
+                                      0, 0, 0, 0, 0, 0, 0xE0, 0x3F};
+  REQUIRE(std::memcmp(buf, expected, 24) == 0);
+
+  record_header h{};
+  REQUIRE(read_header(buf, sizeof(buf), h));
+  REQUIRE(h.version == 1);
+  REQUIRE(h.kind == record_kahan);
+  REQUIRE(h.width == 8);
+  REQUIRE(h.count == 2);
+}
+
+TEST_CASE("Serialize Tests invalid records") {
+  kfloat64 k(1.0, 0.5);
+  unsigned char buf[24];
+  REQUIRE(serialize(k, buf, sizeof(buf)) == 24);
+  // buffer too small
+  REQUIRE(serialize(k, buf, 23) == 0);
+
+  kfloat64 r(7.0);
+  // truncated
+  REQUIRE(deserialize(buf, 23, r) == 0);
+  // other kind
+  nfloat64 n(7.0);
+  REQUIRE(deserialize(buf, 24, n) == 0);
+  REQUIRE(n.getValue() == 7.0);
+  // other width
+  kfloat32 kf(7.0f);
+  REQUIRE(deserialize(buf, 24, kf) == 0);
+  // bad magic or version
+  buf[0] = 'X';
+  REQUIRE(deserialize(buf, 24, r) == 0);
+  buf[0] = 'K';
+  buf[2] = 2;
+  REQUIRE(deserialize(buf, 24, r) == 0);
+  REQUIRE(r.getValue() == 7.0);
+  buf[2] = 1;
+  REQUIRE(deserialize(buf, 24, r) == 24);
+  REQUIRE(r.getValue() == 1.0);
+  REQUIRE(r.getC() == 0.5);
+}
+
+TEST_CASE("Serialize Tests shewchuk state") {
+  sfloat64 s;
+  s += 1e100;
+  s += 1.0;
+  s += 1e-100;
+  REQUIRE(s.size() == 3);
+  std::vector<unsigned char> buf(serialized_size(s));
+  REQUIRE(buf.size() == 8 + 5 * 8);
+  REQUIRE(serialize(s, buf.data(), buf.size()) == buf.size());
+  sfloat64 r;
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(r.size() == 3);
+  r += -1e100;
+  r += -1.0;
+  REQUIRE(r.getValue() == 1e-100);
+
+  // non-finite state
+  sfloat64 inf;
+  inf += std::numeric_limits<double>::infinity();
+  inf += -std::numeric_limits<double>::infinity();
+  buf.resize(serialized_size(inf));
+  REQUIRE(serialize(inf, buf.data(), buf.size()) == buf.size());
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(std::isnan(r.getValue()));
+
+  // intermediate overflow (version 2 record)
+  sfloat64 big;
+  big += 1e308;
+  big += 1e308;
+  buf.resize(serialized_size(big));
+  REQUIRE(buf.size() == 8 + (3 + big.size()) * 8);
+  REQUIRE(serialize(big, buf.data(), buf.size()) == buf.size());
+  REQUIRE(buf[2] == 2);
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(r.getOverflow() == 1);
+  r += -1e308;
+  REQUIRE(r.getValue() == 1e308);
+  // overflow count must be an integer
+  buf[8 + 2 * 8] = 1;
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == 0);
+
+  // partials out of order are rejected
+  sfloat64 two;
+  two += 1.0;
+  two += 1e-30;
+  buf.resize(serialized_size(two));
+  REQUIRE(serialize(two, buf.data(), buf.size()) == buf.size());
+  std::vector<unsigned char> bad(buf);
+  std::memcpy(&bad[24], &buf[32], 8);
+  std::memcpy(&bad[32], &buf[24], 8);
+  REQUIRE(deserialize(bad.data(), bad.size(), r) == 0);
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(r.getValue() == 1.0);
+}
+
+TEST_CASE("Serialize Tests shewchuk exact cancellation") {
+  sfloat64 s;
+  s += 1.0;
+  s += -1.0;
+  REQUIRE(s.size() == 1);
+  REQUIRE(s.partial(0) == 0.0);
+  std::vector<unsigned char> buf(serialized_size(s));
+  REQUIRE(serialize(s, buf.data(), buf.size()) == buf.size());
+  sfloat64 r;
+  r += 5.0;
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(r.size() == 1);
+  REQUIRE(r.getValue() == 0.0);
+  std::stringstream ss;
+  REQUIRE(write_record(ss, s));
+  sfloat64 t;
+  REQUIRE(read_record(ss, t));
+  REQUIRE(t.getValue() == 0.0);
+  // zero top partial above a lower one
+  sfloat64 u;
+  u += 1e-30;
+  u += 1.0;
+  u += -1.0;
+  REQUIRE(u.size() == 2);
+  buf.resize(serialized_size(u));
+  REQUIRE(serialize(u, buf.data(), buf.size()) == buf.size());
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == buf.size());
+  REQUIRE(r.getValue() == 1e-30);
+  // zero is only valid on top
+  sfloat64 v;
+  v += 1e-30;
+  v += 1.0;
+  buf.resize(serialized_size(v));
+  REQUIRE(serialize(v, buf.data(), buf.size()) == buf.size());
+  std::memset(&buf[8 + 2 * 8], 0, 8);
+  REQUIRE(deserialize(buf.data(), buf.size(), r) == 0);
+}
+
+TEST_CASE("Serialize Tests concatenated records on streams") {
+  nfloat64 n;
+  n += 1e100;
+  n += 1.0;
+  n += -1e100;
+  sfloat64 s;
+  s += 0.1;
+  s += 0.2;
+  std::stringstream ss;
+  REQUIRE(write_record(ss, n));
+  REQUIRE(write_record(ss, s));
+
+  nfloat64 rn;
+  sfloat64 rs;
+  REQUIRE(read_record(ss, rn));
+  REQUIRE(read_record(ss, rs));
+  REQUIRE(rn.getValue() == 1.0);
+  REQUIRE(rs.getValue() == s.getValue());
+  // end of stream
+  REQUIRE(!read_record(ss, rn));
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <limits>  // numeric_limits
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>      // 'src' included
+#include <kahan-float/parallel.hpp>  // 'src' included
+#include <kahan-float/sum.hpp>       // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// random signs and magnitudes
+static std::vector<double> random_magnitudes(unsigned seed, std::size_t n) {
+  std::default_random_engine engine(seed);
+  std::uniform_real_distribution<double> rexp(-10.0, 10.0);
+  std::bernoulli_distribution rsign(0.5);
+  std::vector<double> v(n);
+  for (std::size_t i = 0; i < n; i++)
+    v[i] = (rsign(engine) ? -1.0 : 1.0) * ::pow(10.0, rexp(engine));
+  return v;
+}
+
+TEST_CASE("Sum Tests bulk_sum empty and small") {
+  std::vector<double> v;
+  REQUIRE(bulk_sum<double>(v.data(), 0).getValue() == 0.0);
+  v = {1, 1e100, 1, -1e100};
+  REQUIRE(bulk_sum<double>(v.data(), v.size()) == 2.0);
+}
+
+TEST_CASE("Sum Tests bulk_sum matches fsum") {
+  std::vector<double> v = random_magnitudes(0, 10007);
+  double exact = fsum(v.data(), v.size());
+  REQUIRE(bulk_sum<double>(v.data(), v.size()).getValue() == exact);
+}
+
+TEST_CASE("Sum Tests bulk_sum float into double") {
+  std::vector<float> v(1000, 0.1f);
+  // 0.1f is not 0.1: exact sum is 1000 * 0.100000001490116...
+  REQUIRE(bulk_sum<double>(v.data(), v.size()).getValue() ==
+          1000 * (double)0.1f);
+  REQUIRE(bulk_sum<float>(v.data(), v.size()).getValue() == 100.0f);
+}
+
+TEST_CASE("Sum Tests bulk_add into accumulators") {
+  std::vector<double> v = random_magnitudes(1, 999);
+  double exact = fsum(v.data(), v.size());
+  nfloat64 n = 0;
+  bulk_add(n, v.data(), v.size());
+  REQUIRE(n.getValue() == exact);
+  sfloat64 s;
+  bulk_add(s, v.data(), v.size());
+  REQUIRE(s.getValue() == exact);
+}
+
+TEST_CASE("Sum Tests bulk_sum inf nan") {
+  std::vector<double> v(100, 1.0);
+  v[10] = std::numeric_limits<double>::infinity();
+  REQUIRE(bulk_sum<double>(v.data(), v.size()).getValue() ==
+          std::numeric_limits<double>::infinity());
+  v[20] = -std::numeric_limits<double>::infinity();
+  REQUIRE(std::isnan(bulk_sum<double>(v.data(), v.size()).getValue()));
+}
+
+TEST_CASE("Sum Tests parallel_sum deterministic") {
+  std::vector<double> v = random_magnitudes(2, 1 << 20);
+  double exact = fsum(v.data(), v.size());
+  double r1 = parallel_sum<double>(v.data(), v.size(), 1).getValue();
+  double r4 = parallel_sum<double>(v.data(), v.size(), 4).getValue();
+  double r4b = parallel_sum<double>(v.data(), v.size(), 4).getValue();
+  REQUIRE(r1 == exact);
+  REQUIRE(r4 == exact);
+  REQUIRE(r4 == r4b);
+  // small inputs run on a single thread
+  REQUIRE(parallel_sum<double>(v.data(), 10, 8).getValue() ==
+          bulk_sum<double>(v.data(), 10).getValue());
+}
@@ -0,0 +1,151 @@
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/kahan.hpp>
+#include <kahan-float/neumaier.hpp>
+#include <kahan-float/table.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// counts allocations (shared by all rebound copies)
+static std::size_t table_allocs = 0;
+
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+  counting_allocator() {}
+  template <class U>
+  counting_allocator(const counting_allocator<U>&) {}
+  T* allocate(std::size_t n) {
+    table_allocs++;
+    return static_cast<T*>(std::malloc(n * sizeof(T)));
+  }
+  void deallocate(T* p, std::size_t) { std::free(p); }
+  template <class U>
+  bool operator==(const counting_allocator<U>&) const {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const counting_allocator<U>&) const {
+    return false;
+  }
+};
+
+TEST_CASE("Table Tests group-by sums") {
+  accumulator_table<int, nfloat64> t;
+  REQUIRE(t.empty());
+  t.add(1, 1e16);
+  t.add(2, 0.5);
+  t.add(1, 1.0);
+  t.add(1, -1e16);
+  REQUIRE(t.size() == 2);
+  REQUIRE(t.getValue(1) == 1.0);
+  REQUIRE(t.getValue(2) == 0.5);
+  REQUIRE(t.getValue(3) == 0.0);
+  REQUIRE(t.find(3) == nullptr);
+  REQUIRE(t.find(1)->getValue() == 1.0);
+
+  // bulk, with heavy keys
+  std::vector<int> keys;
+  std::vector<double> v;
+  std::map<int, sfloat64> exact;
+  for (int i = 0; i < 10000; i++) {
+    int k = (i % 3 == 0) ? 7 : i % 11;
+    double x = (i % 2) ? 1e10 : 0.1;
+    if (i % 4 == 1) x = -1e10;
+    keys.push_back(k);
+    v.push_back(x);
+    exact[k] += x;
+  }
+  accumulator_table<int, nfloat64> b;
+  b.add(keys.data(), v.data(), keys.size());
+  int wrong = 0;
+  for (auto& kv : exact)
+    if (b.getValue(kv.first) != kv.second.getValue()) wrong++;
+  REQUIRE(wrong == 0);
+  std::vector<int> sorted = b.sorted_keys();
+  REQUIRE(sorted.size() == exact.size());
+  REQUIRE(sorted.front() == exact.begin()->first);
+
+  // merge keeps corrections of both sides
+  accumulator_table<int, nfloat64> m1, m2;
+  m1.add(5, 1e16);
+  m1.add(5, 1.0);
+  m2.add(5, -1e16);
+  m2.add(5, 1.0);
+  m2.add(6, 2.0);
+  m1.merge(m2);
+  REQUIRE(m1.getValue(5) == 2.0);
+  REQUIRE(m1.getValue(6) == 2.0);
+  m1.clear();
+  REQUIRE(m1.empty());
+}
+
+TEST_CASE("Table Tests allocators") {
+  using table = accumulator_table<int, kfloat64, std::hash<int>,
+                                  std::equal_to<int>, counting_allocator<int>>;
+  table_allocs = 0;
+  {
+    table t{counting_allocator<std::pair<const int, kfloat64>>()};
+    for (int i = 0; i < 100; i++) t.add(i % 10, 0.1);
+    kfloat64 e;
+    for (int i = 0; i < 10; i++) e += 0.1;
+    REQUIRE(t.getValue(3) == e.getValue());
+    table copy(t, t.get_allocator());
+    REQUIRE(copy.getValue(3) == t.getValue(3));
+  }
+  REQUIRE(table_allocs > 0);  // nodes and buckets from the allocator
+}
+
+#if KAHAN_HAS_PMR
+
+// counts allocations reaching the upstream resource
+struct counting_resource : std::pmr::memory_resource {
+  std::size_t count{0};
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    count++;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& o) const
+      noexcept override {
+    return this == &o;
+  }
+};
+
+TEST_CASE("Table Tests pmr arena") {
+  counting_resource upstream;
+  alignas(64) static char buf[1 << 16];
+  for (int request = 0; request < 100; request++) {
+    std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf), &upstream);
+    kahan::pmr::accumulator_table<int, nfloat64> t(&arena);
+    for (int i = 0; i < 300; i++) t.add(i % 17, 0.1 * i);
+    REQUIRE(t.size() == 17);
+    kahan::pmr::vector<nfloat64> cols(8, &arena);
+    cols[3] += 1e16;
+    cols[3] += 1.0;
+    cols[3] += -1e16;
+    REQUIRE(cols[3].getValue() == 1.0);
+    // tables in a pmr container share the arena
+    std::pmr::vector<kahan::pmr::accumulator_table<int, nfloat64>> tables(
+        &arena);
+    tables.emplace_back();
+    tables[0].add(1, 2.0);
+    REQUIRE(tables[0].get_allocator().resource() == &arena);
+  }  // all freed at once
+  REQUIRE(upstream.count == 0);  // no allocation left the arena
+}
+
+#endif  // KAHAN_HAS_PMR
@@ -0,0 +1,65 @@
+// built as a separate executable: KAHAN_TELEMETRY changes 'operator+='
+#ifndef KAHAN_TELEMETRY
+#define KAHAN_TELEMETRY
+#endif
+
+#include <limits>
+#include <thread>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/kahan.hpp>     // 'src' included
+#include <kahan-float/neumaier.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+TEST_CASE("Telemetry Tests counts events") {
+  telemetry::reset();
+  kfloat64 k;
+  k += 1.0;
+  k += 2.0;
+  REQUIRE(telemetry::snapshot().adds == 2);
+  REQUIRE(telemetry::snapshot().cancellations == 0);
+  k += -3.0 + 1e-12;  // 3 - 3 + 1e-12: catastrophic
+  REQUIRE(telemetry::snapshot().cancellations == 1);
+  // inf input: c becomes nan and is reset
+  k += std::numeric_limits<double>::infinity();
+  telemetry::counters c = telemetry::snapshot();
+  REQUIRE(c.adds == 4);
+  REQUIRE(c.infinities == 1);
+  REQUIRE(c.nan_resets == 1);
+  REQUIRE(c.c_overflows == 0);
+
+  telemetry::reset();
+  nfloat64 n;
+  n += 1e308;
+  n += 1e308;  // overflow
+  c = telemetry::snapshot();
+  REQUIRE(c.adds == 2);
+  REQUIRE(c.c_overflows == 1);
+  REQUIRE(c.nan_resets == 0);  // c is -inf here, not nan
+  // lazy steps keep nan until read: no reset
+  telemetry::reset();
+  nbfloat64 b;
+  b += std::numeric_limits<double>::infinity();
+  b += 1.0;
+  REQUIRE(telemetry::snapshot().infinities == 1);
+  REQUIRE(telemetry::snapshot().nan_resets == 0);
+}
+
+TEST_CASE("Telemetry Tests all threads") {
+  telemetry::counters before = telemetry::snapshot_all();
+  std::thread t([] {
+    kfloat32 f;
+    for (int i = 0; i < 100; i++) f += 1.0f;
+  });
+  t.join();  // exited thread is kept in totals
+  telemetry::counters after = telemetry::snapshot_all();
+  REQUIRE(after.adds == before.adds + 100);
+  REQUIRE(telemetry::snapshot().adds <= after.adds);
+}
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef HEADER_ONLY
+#include <catch2/catch_amalgamated.hpp>  // HEADER_ONLY
+#else
+#include <catch2/catch_all.hpp>
+#endif
+
+#include <kahan-float/fsum.hpp>
+#include <kahan-float/tracked.hpp>  // 'src' included
+
+using namespace std;
+using namespace kahan;
+
+// correctly rounded |exact sum of x - v|
+static double exact_error(const std::vector<double>& x, double v) {
+  sfloat64 s;
+  for (double e : x) s += e;
+  s += -v;
+  return std::fabs(s.getValue());
+}
+
+// large terms cancelling in pairs, plus small noise
+static std::vector<double> ill_conditioned(size_t n, unsigned seed) {
+  std::default_random_engine engine(seed);
+  std::uniform_real_distribution<double> runif(-1, 1);
+  std::vector<double> x(n);
+  for (size_t i = 0; i < n; i += 2) {
+    x[i] = runif(engine) * 1e16;
+    if (i + 1 < n) x[i + 1] = -x[i] + runif(engine);
+  }
+  return x;
+}
+
+TEST_CASE("Tracked Tests counters") {
+  tnfloat64 t;
+  REQUIRE(t.getCount() == 0);
+  REQUIRE(t.error_bound() == 0.0);
+  t += 1e16;
+  t += 1.0;
+  t -= 2.0;
+  REQUIRE(t.getCount() == 3);
+  REQUIRE(t.getAbsSum() == (1e16 + 1.0) + 2.0);  // plain sum
+  REQUIRE(t.getValue() == 1e16 - 1.0);
+  REQUIRE(t.get().getValue() == t.getValue());
+  REQUIRE(t.getMaxC() == 1.0);  // 1e16 + 1 lost 1
+  tkfloat64 k = 2.0;
+  k = k + 3.0;
+  REQUIRE(k.getCount() == 2);
+  REQUIRE(k.getValue() == 5.0);
+  REQUIRE(k.getMaxC() == 0.0);
+  // exact sums of integers: bound is not zero but tiny
+  REQUIRE(k.within(1e-14));
+}
+
+TEST_CASE("Tracked Tests bound holds") {
+  for (unsigned t = 0; t < 20; t++) {
+    std::vector<double> x = ill_conditioned(1000 + 37 * t, t);
+    tkfloat64 k;
+    tnfloat64 nb;
+    tnbfloat64 nbl;
+    for (double e : x) {
+      k += e;
+      nb += e;
+      nbl += e;
+    }
+    REQUIRE(exact_error(x, k.getValue()) <= k.error_bound());
+    REQUIRE(exact_error(x, nb.getValue()) <= nb.error_bound());
+    REQUIRE(exact_error(x, nbl.getValue()) <= nbl.error_bound());
+    // neumaier bound is a-posteriori: much tighter than kahan's
+    REQUIRE(nb.error_bound() < k.error_bound());
+  }
+  // float
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<float> runif(-1, 1);
+  tkfloat32 kf;
+  tnfloat32 nf;
+  std::vector<double> xd;
+  for (int i = 0; i < 5000; i++) {
+    float v = runif(engine) * ((i % 3 == 0) ? 1e6f : 1.0f);
+    kf += v;
+    nf += v;
+    xd.push_back(v);
+  }
+  REQUIRE(exact_error(xd, kf.getValue()) <= kf.error_bound());
+  REQUIRE(exact_error(xd, nf.getValue()) <= nf.error_bound());
+}
+
+TEST_CASE("Tracked Tests escalation") {
+  // well-conditioned: bound is about one ulp, no exact path needed
+  std::default_random_engine engine(1);
+  std::uniform_real_distribution<double> runif(0, 1);
+  tnfloat64 good;
+  for (int i = 0; i < 10000; i++) good += runif(engine);
+  REQUIRE(good.rel_error_bound() < 1e-15);
+  // ill-conditioned: bound is larger than tolerance, run exact path
+  std::vector<double> x = ill_conditioned(10000, 2);
+  tnfloat64 bad;
+  for (double e : x) bad += e;
+  const double tol = 1e-15 * std::fabs(bad.getValue());
+  REQUIRE(!bad.within(tol));
+  double result = bad.getValue();
+  if (!bad.within(tol)) {
+    sfloat64 exact;
+    for (double e : x) exact += e;
+    result = exact.getValue();
+  }
+  REQUIRE(exact_error(x, result) <= tol);
+}
+
+TEST_CASE("Tracked Tests special values") {
+  const double inf = std::numeric_limits<double>::infinity();
+  tnfloat64 t;
+  t += 1.0;
+  t += inf;
+  REQUIRE(t.error_bound() == inf);
+  REQUIRE(!t.within(1e300));
+  tkfloat64 k;
+  k += std::numeric_limits<double>::quiet_NaN();
+  REQUIRE(k.error_bound() == inf);
+  tkfloat64 z;
+  z += 0.0;
+  REQUIRE(z.rel_error_bound() == 0.0);
+  z += 1.0;
+  z += -1.0;
+  REQUIRE(z.rel_error_bound() == inf);  // bound > 0, value is zero
+}